@@ -2,10 +2,63 @@
 
 #include "A_star_functions.h"
 
+#include <algorithm>
+#include <limits>
+
+/* Boundary value of a cell (0 if not a boundary cell) */
+int boundary_pt_value(size_t i, size_t j, size_t row_PT, size_t col_PT) {
+
+	// Predefine collumn and row end points
+	size_t row_end_pt = row_PT - 1; 
+	size_t col_end_pt = col_PT - 1; 
+
+	/* Boundary points*/
+	/* B_IDs :	BL corner	= 1
+				B edge		= 2
+				BR corner	= 3
+				L edge		= 4 
+				R edge		= 5 
+				TL corner	= 6
+				T edge		= 7 
+				TR corner	= 8
+	*/
+	if (i == 0 && j == 0) {					// Bottom left corner point
+		return 1;
+	}
+	else if (i == 0 && j < col_end_pt) {			// Bottom edge without BR corner
+		return 2;
+	}
+	else if (i == 0 && j == col_end_pt) {			// Bottom right corner
+		return 3;
+	}
+	else if (i > 0 && i < row_end_pt && j == 0) {		// Left edge
+		return 4;
+	}
+	else if (i > 0 && i < row_end_pt && j == col_end_pt) {	// Right edge
+		return 5;
+	}
+	else if (i == row_end_pt && j == 0) {			// Top left corner
+		return 6;
+	}
+	else if (i == row_end_pt && j > 0 && j < col_end_pt) {	// Top edge
+		return 7;
+	}
+	else if (i == row_end_pt && j == col_end_pt) {		// Top right edge
+		return 8;
+	}
+
+	// Normal cell
+	return 0;
+}
+
 /* Grid generation function (Cartesian uniform grid) */
-void grid_generation(RMF::DYN_C2D<Cell_ds>& grid, size_t row_PT, size_t col_PT, float spacing) {
-	
+void grid_generation(Cell_grid& grid, size_t row_PT, size_t col_PT, float spacing) {
 	
+#if GRID_LAYOUT==2
+	// Paged grid constructs the cells (including boundary values) when their tile is first loaded, nothing is materialised here
+	grid.set_Spacing(spacing);
+	grid.reserve(row_PT, col_PT);
+#else
 	// Pre-allocate memory and construct Cell_ds entities. Note, DYN_C2D::emplace_back(object, rows) reserves memory in function, however, with
 	// DYN_C2D::emplace_back(objects(parameters)) this has to be done manually. 
 
@@ -17,10 +70,6 @@ void grid_generation(RMF::DYN_C2D<Cell_ds>& grid, size_t row_PT, size_t col_PT,
 	float ypos = 0.0f;
 	float xpos = 0.0f;
 
-	// Predefine collumn and row end points (so only need to calculate once 
-	size_t row_end_pt = row_PT - 1; 
-	size_t col_end_pt = col_PT - 1; 
-
 	for (size_t i = 0; i < row_PT; i++) {
 		for (size_t j = 0; j < col_PT; j++) {
 
@@ -30,46 +79,10 @@ void grid_generation(RMF::DYN_C2D<Cell_ds>& grid, size_t row_PT, size_t col_PT,
 			xpos += spacing;		// Update X position
 
 			/* Setting boundary points*/
-			/* B_IDs :	BL corner	= 1
-						B edge		= 2
-						BR corner	= 3
-						L edge		= 4 
-						R edge		= 5 
-						TL corner	= 6
-						T edge		= 7 
-						TR corner	= 8
-			*/
-			if (i == 0 && j == 0) {					// Bottom left corner point
-				grid(i, j).set_Boundary_pt(); 
-				grid(i, j).set_Boundary_pt_val(1);
-			}
-			else if (i == 0 && j < col_end_pt) {			// Bottom edge without BR corner
-				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(2);
-			}
-			else if (i == 0 && j == col_end_pt) {			// Bottom right corner
-				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(3);
-			}
-			else if (i > 0 && i < row_end_pt && j == 0) {		// Left edge
-				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(4);
-			}
-			else if (i > 0 && i < row_end_pt && j == col_end_pt) {	// Right edge
-				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(5);
-			}
-			else if (i == row_end_pt && j == 0) {			// Top left corner
-				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(6);
-			}
-			else if (i == row_end_pt && j > 0 && j < col_end_pt) {	// Top edge
-				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(7);
-			}
-			else if (i == row_end_pt && j == col_end_pt) {		// Top right edge
+			int boundary_val = boundary_pt_value(i, j, row_PT, col_PT);
+			if (boundary_val != 0) {
 				grid(i, j).set_Boundary_pt();
-				grid(i, j).set_Boundary_pt_val(8);
+				grid(i, j).set_Boundary_pt_val(boundary_val);
 			}
 
 
@@ -78,6 +91,7 @@ void grid_generation(RMF::DYN_C2D<Cell_ds>& grid, size_t row_PT, size_t col_PT,
 		xpos = 0.0f;				// Re-zero xpos as starting from next row 
 		ypos += spacing;			// Update ypos 
 	}
+#endif
 
 	/* Debug print grid */
 	#if DEBUG==0
@@ -92,7 +106,7 @@ void grid_generation(RMF::DYN_C2D<Cell_ds>& grid, size_t row_PT, size_t col_PT,
 }
 
 /* Obstacle generation */
-void obstacle_generation(RMF::DYN_C2D<Cell_ds>& grid, int row_PT, int col_PT, int obstacle_setting) {
+void obstacle_generation(Cell_grid& grid, int row_PT, int col_PT, int obstacle_setting) {
 
 	switch (obstacle_setting) {
 		case (1):			// Uniform cells as objects 
@@ -132,7 +146,9 @@ std::vector<Cell_ds> min_FHcost(std::vector<Cell_ds>& priority_list, Cell_ds*& p
 
 	// This is initial conditions and depending on this, the algorithm can get stuck
 	// (i.e. if you use the parent point it gets stuck if it cant find a better g and h cost)
-	int min_fcost = 2*priority_list[0].get_Fcost();	// Set min f_cost
+	// Start from the largest int so any cell not yet been a parent is selected. If the returned cell has already been a parent,
+	// there are no cells left to evaluate (used by A_star_search to detect an unreachable end point) 
+	int min_fcost = std::numeric_limits<int>::max();	// Set min f_cost
 	//int min_fcost = pt_A.get_Fcost();
 
 	// Initialize a cell in a vector with  minimum fcost for processing (vector as I also may want to return multiple cells in future for optomizing the algortithm)
@@ -186,23 +202,26 @@ std::vector<Cell_ds> min_FHcost(std::vector<Cell_ds>& priority_list, Cell_ds*& p
 }
 
 /* A* algorithm implementation */
-void A_star_algorithm(size_t(&loop_index)[4], RMF::DYN_C2D<Cell_ds>& grid, std::vector<Cell_ds>& priority_list, size_t& priolist_index, Cell_ds*& parent_pt, Cell_ds& pt_B, const size_t& p_col, const size_t& p_row, const int& diag_movement, const int& adj_movement) {
+void A_star_algorithm(size_t(&loop_index)[4], Search_state& state, std::vector<Cell_ds>& priority_list, size_t& priolist_index, Cell_ds*& parent_pt, Cell_ds& pt_B, const size_t& p_col, const size_t& p_row, const int& diag_movement, const int& adj_movement, const Landmark_heuristic* landmarks) {
 
 	// Loop for upper and lower limits 
 	for (size_t i = loop_index[0]; i <= loop_index[1]; i = i + 1) {
 		
 		for (size_t j = loop_index[2]; j <= loop_index[3]; j++) {
 
+			// The search's own copy of the cell (obstacle flag from the map snapshot if the search has one)
+			Cell_ds& cell = state(i, j);
+
 			// Condition if the cell has been a parent before (don't evaluate) and don't evaulate the actual current parent cell 
-			if (grid(i, j).get_Parent_eval() == true || (j == p_col && i == p_row) || grid(i, j).get_Obstacle() == true) {
+			if (cell.get_Parent_eval() == true || (j == p_col && i == p_row) || cell.get_Obstacle() == true) {
 				continue;	 // Dont evaluate statement which goes to next iteration of for loop 
 						 // In terms of obstacles, not evaluating means it will not be put on the priolist and therefore not considered in the path
 			}
 			// Check if it has been a child cell before --> compare the movement costs (gcosts)
-			else if (grid(i, j).get_On_priolist() == true) {
+			else if (cell.get_On_priolist() == true) {
 
 				// Predefine the index which the cell is allocated on the priority list
-				size_t priolist_cell_index = grid(i, j).get_Priolist_index();
+				size_t priolist_cell_index = cell.get_Priolist_index();
 
 				// Conditions for adjacent movement (Combinations of indices)
 				if ((i == p_row - 1 && j == p_col) || (i == p_row + 1 && j == p_col) || (i == p_row && j == p_col - 1) || (i == p_row && j == p_col + 1)) {
@@ -211,30 +230,34 @@ void A_star_algorithm(size_t(&loop_index)[4], RMF::DYN_C2D<Cell_ds>& grid, std::
 					int movement = adj_movement;
 
 					// Calculate the potential new gcost 
-					int potential_new_gcost = grid(i, j).generate_gcost(parent_pt, movement);
+					int potential_new_gcost = cell.generate_gcost(parent_pt, movement);
 
 					// Compare the movement costs and select the lowest one 
 					if (potential_new_gcost < priority_list[priolist_cell_index].get_Gcost()) {
 
-						// Update the cell data 
-						grid(i, j).set_Gcost(potential_new_gcost);
+						// Update the cell data (fcost too, the priority list is ordered on it)
+						cell.set_Gcost(potential_new_gcost);
+						cell.generate_fcost();
 
 						// Let the currently evaluated cell know its new parent
-						grid(i, j).set_From_Cell_ID(parent_pt->get_ID());
+						cell.set_From_Cell_ID(parent_pt->get_ID());
 
 						// Update the priority list 
 						priority_list[priolist_cell_index].set_Gcost(potential_new_gcost);
+						priority_list[priolist_cell_index].generate_fcost();
 						priority_list[priolist_cell_index].set_From_Cell_ID(parent_pt->get_ID());
 					}
 				}
 				else {	// else, diagonal movement
 					int movement = diag_movement;
-					int potential_new_gcost = grid(i, j).generate_gcost(parent_pt, movement);
+					int potential_new_gcost = cell.generate_gcost(parent_pt, movement);
 
 					if (potential_new_gcost < priority_list[priolist_cell_index].get_Gcost()) {
-						grid(i, j).set_Gcost(potential_new_gcost);
-						grid(i, j).set_From_Cell_ID(parent_pt->get_ID());
+						cell.set_Gcost(potential_new_gcost);
+						cell.generate_fcost();
+						cell.set_From_Cell_ID(parent_pt->get_ID());
 						priority_list[priolist_cell_index].set_Gcost(potential_new_gcost);
+						priority_list[priolist_cell_index].generate_fcost();
 						priority_list[priolist_cell_index].set_From_Cell_ID(parent_pt->get_ID());
 					}
 				}
@@ -249,27 +272,316 @@ void A_star_algorithm(size_t(&loop_index)[4], RMF::DYN_C2D<Cell_ds>& grid, std::
 					int movement = adj_movement;
 
 					// Calculate the potential new gcost 
-					grid(i, j).set_Gcost(grid(i, j).generate_gcost(parent_pt, movement));
-					grid(i, j).generate_heurcost(pt_B, diag_movement, adj_movement);
-					grid(i, j).generate_fcost();
+					cell.set_Gcost(cell.generate_gcost(parent_pt, movement));
+					cell.generate_heurcost(pt_B, diag_movement, adj_movement);
+					if (landmarks != nullptr) {
+						cell.raise_heurcost(landmarks->lower_bound(cell.get_Contig_pos(), pt_B.get_Contig_pos()));
+					}
+					cell.generate_fcost();
 
 					// Let the currently evaluated cell know which parent it is from
-					grid(i, j).set_From_Cell_ID(parent_pt->get_ID());
+					cell.set_From_Cell_ID(parent_pt->get_ID());
 				}
 				else {	// else, diagonal movement
 					int movement = diag_movement;
-					grid(i, j).set_Gcost(grid(i, j).generate_gcost(parent_pt, movement));
-					grid(i, j).generate_heurcost(pt_B, diag_movement, adj_movement);
-					grid(i, j).generate_fcost();
-					grid(i, j).set_From_Cell_ID(parent_pt->get_ID());
+					cell.set_Gcost(cell.generate_gcost(parent_pt, movement));
+					cell.generate_heurcost(pt_B, diag_movement, adj_movement);
+					if (landmarks != nullptr) {
+						cell.raise_heurcost(landmarks->lower_bound(cell.get_Contig_pos(), pt_B.get_Contig_pos()));
+					}
+					cell.generate_fcost();
+					cell.set_From_Cell_ID(parent_pt->get_ID());
 				}
 
 				// Put cell on priority list, assign it an index on the priority list for future reference and increment the priority list index
-				grid(i, j).set_On_priolist();
-				grid(i, j).set_Priolist_index(priolist_index);
+				cell.set_On_priolist();
+				cell.set_Priolist_index(priolist_index);
 				priolist_index += 1;
-				priority_list.push_back(grid(i, j));
+				priority_list.push_back(cell);
 			}
 		} // End of jth loop of neighbouring cells
 	} // End of ith loop of neighbouring cellsuring cells
 }
+
+/* Check search limits (deadline, expansion budget and cancellation) */
+bool check_search_limits(const Search_limits& limits, size_t expansions, Search_result& stop_reason) {
+
+	// Cancellation first as it is the cheapest check and the caller wants out asap
+	if (limits.cancel_token != nullptr && limits.cancel_token->load(std::memory_order_relaxed) == true) {
+		stop_reason = Search_result::cancelled;
+		return true;
+	}
+	if (limits.max_expansions != 0 && expansions >= limits.max_expansions) {
+		stop_reason = Search_result::budget_exceeded;
+		return true;
+	}
+	if (limits.deadline != std::chrono::steady_clock::time_point::max() && std::chrono::steady_clock::now() >= limits.deadline) {
+		stop_reason = Search_result::budget_exceeded;
+		return true;
+	}
+
+	// Search can continue 
+	return false;
+}
+
+/* Backtrack the path from a cell to the start cell using the from cell IDs */
+void backtrack_path(Search_state& state, int end_cell_ID, std::vector<int>& path_cell_IDs) {
+
+	// Pointer to current end cell. Note, cell ID is the same as contiguous index for the search state (and the grid)
+	Cell_ds* backtrack_cell_pointer = &state(end_cell_ID);
+
+	// Store cell ID of target cell for plotting
+	path_cell_IDs.clear();
+	path_cell_IDs.push_back(backtrack_cell_pointer->get_ID());
+
+	// While loop where the condition is if it is the start cell (which the grid cells are aware of) 
+	while (backtrack_cell_pointer->get_isStart() == false) {
+
+		// Get the ID of the parent cell of current cell backtrack_cell_pointer is pointing too. 
+		int from_parent_cell_ID = backtrack_cell_pointer->get_From_Cell_ID();
+		path_cell_IDs.push_back(from_parent_cell_ID);				// Store path cell ID 
+
+		// Point to the parent cell of the current cell and repeat until the start point is reached. 
+		backtrack_cell_pointer = &state(from_parent_cell_ID);
+		backtrack_cell_pointer->set_Plot_path_activator();			// Set the cell to plot when called by the plotter
+	}
+
+	// Path was collected end -> start, store it start -> end 
+	std::reverse(path_cell_IDs.begin(), path_cell_IDs.end());
+}
+
+/* Full A* search from the start to the end cell of the search state within the search limits */
+Search_outcome A_star_search(Search_state& state, size_t row_PT, size_t col_PT, const int& diag_movement, const int& adj_movement, const Search_limits& limits, const Component_labels* components, const Landmark_heuristic* landmarks) {
+
+	Search_outcome outcome; 
+
+	// Labels and landmark tables built from another version of the map than the search's snapshot are not used (an edit can 
+	// connect components or open a shortcut which makes the landmark bound inadmissible)
+	const Map_snapshot* map = state.get_Map();
+	if (map != nullptr && components != nullptr && components->get_Map_version() != map->get_Version()) {
+		components = nullptr;
+	}
+	if (map != nullptr && landmarks != nullptr && landmarks->get_Map_version() != map->get_Version()) {
+		landmarks = nullptr;
+	}
+
+	/* -------------------------- Start and end points (point A and B) -------------------------- */
+	// The search state knows which cells are the start and end points. The start point is the first parent
+	Cell_ds& pt_A = state(state.get_Start_ID());
+	Cell_ds& pt_B = state(state.get_End_ID());
+
+	pt_A.set_Parent_eval(true);
+	pt_A.set_Gcost(0);
+	pt_A.generate_heurcost(pt_B, diag_movement, adj_movement);
+	pt_A.generate_fcost();
+
+	// O(1) rejection if the start and end points are in different connected components (no need to exhaust every reachable cell)
+	if (components != nullptr && components->same_component(pt_A.get_Contig_pos(), pt_B.get_Contig_pos()) == false) {
+		outcome.result = Search_result::unreachable;
+		backtrack_path(state, pt_A.get_ID(), outcome.path_cell_IDs);
+		return outcome;
+	}
+
+	/* -------------------------- Set first parent cell as start cell -------------------------- */
+	Cell_ds* parent_pt = &pt_A;				// Parent_pt is a pointer which switches from difernt cells (should do that, currently pointing to container for parent cell after the initial condition)..
+	std::vector<Cell_ds> container_for_parent_cell;		// Need to optomize this out if using a vector of possible parent cells is not good. 
+
+	/*------------------------------- Initalize a priority list ----------------------------------*/
+	/*Choose which cell to evaluate next based on smallest fcost/hcosts
+	This has elements added to it (cells) as the algorithm progresses */
+
+	std::vector<Cell_ds> priority_list;	
+	size_t				 priolist_index = 0;
+	
+	// Reserve memory up front, bounded so a huge (e.g. paged) map does not reserve a list larger than the map itself,
+	// the list grows past this as normal if it has to
+	const size_t priolist_reserve_limit = 4096;
+	priority_list.reserve(std::min(col_PT * row_PT, priolist_reserve_limit));
+
+	// Closed cell closest to the end point (lowest hcost) for the best partial path if the search is stopped early
+	int best_cell_ID	= pt_A.get_ID();
+	int best_hcost		= pt_A.get_Hcost();
+
+	/* ------------------------------ Start of A* search algorithm ------------------------------ */
+
+	while (parent_pt->get_isEnd() == false) {
+
+		// Predefine index of parent cell 
+		size_t p_row = parent_pt->get_Row_pos(); 
+		size_t p_col = parent_pt->get_Col_pos();
+		
+		/* Get points surrounding current_pt (will be 8 points including diagonals if parent is not a boundary cell) */
+		/* Boundary cell filtering -> boundary cells must be treated differently as the available neighbouring cells are different*/
+
+		// Switch for different types of boundaries
+		/* B_IDs :	Normal cell = 0
+					BL corner	= 1
+					B edge		= 2
+					BR corner	= 3
+					L edge		= 4
+					R edge		= 5
+					TL corner	= 6
+					T edge		= 7
+					TR corner	= 8
+		*/
+
+		switch (parent_pt->get_Boundary_pt_val()) {
+			case 0: {	// Normal cell
+
+				// Indexed lrow_lim[0], urow_lim[1], lcol_lim[2], lcol_lim[3]
+				size_t neighbour_limits[4]{ p_row - 1, p_row + 1, p_col - 1, p_col + 1 };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 1: {	// Bottom left corner cell (do not consider points at row - 1, col - 1 area) 
+
+				size_t neighbour_limits[4]{ p_row, p_row + 1, p_col , p_col + 1 };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 2: {	// Bottom edge 
+
+				size_t neighbour_limits[4]{ p_row, p_row + 1, p_col - 1, p_col + 1 };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 3: {	// Bottom right corner 
+
+				size_t neighbour_limits[4]{ p_row, p_row + 1, p_col - 1, p_col };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 4: {	// Left edge 
+
+				size_t neighbour_limits[4]{ p_row - 1, p_row + 1, p_col, p_col + 1 };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 5: {	// Right edge
+
+				size_t neighbour_limits[4]{ p_row - 1, p_row + 1, p_col -1, p_col };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 6: {	// Top left corner 
+
+				size_t neighbour_limits[4]{ p_row - 1, p_row, p_col, p_col + 1 };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 7: {	// Top edge
+
+				size_t neighbour_limits[4]{ p_row - 1, p_row, p_col - 1, p_col + 1 };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+			case 8: {	// Top right corner
+
+				size_t neighbour_limits[4]{ p_row - 1, p_row, p_col - 1, p_col };
+				A_star_algorithm(neighbour_limits, state, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement, landmarks);
+				break;
+			}
+		}
+
+		// No cells were ever put on the priority list (start cell is walled in) 
+		if (priority_list.empty() == true) {
+			outcome.result = Search_result::unreachable;
+			break;
+		}
+
+		/* Select new parent cell for the minimum fcost -> minimum hcost if fcosts are the same */
+		container_for_parent_cell = min_FHcost(priority_list, parent_pt, pt_A);	// Not ideal, but using vector for possible optimizations of code structure later
+		parent_pt = &container_for_parent_cell[0];				// Set parent cell pointer to the new parent cell. 
+
+		// If the selected cell has already been a parent, every cell on the priority list has been evaluated (open list is empty)
+		// and the end point cannot be reached from the start point 
+		if (parent_pt->get_Parent_eval() == true) {
+			outcome.result = Search_result::unreachable;
+			break;
+		}
+
+#if DEBUG==0 
+		// Print fcost values of priority list 
+		for (size_t ip = 0; ip < priority_list.size(); ip++) {
+			std::cout << "Fcost of cell " << priority_list[ip].get_ID() << " : " << priority_list[ip].get_Fcost() << "\n"; 
+			std::cout << "Hcost of cell " << priority_list[ip].get_ID() << " : " << priority_list[ip].get_Hcost() << "\n";
+		}
+#endif
+		/* Set new parent cell to acknoledge it is a parent cell.*/
+		// Note, cell ID is the same as contiguous index for the search state (and the grid) since ID is 0 -> N cells and contig ind is 0 -> N cells.
+		state(parent_pt->get_ID()).set_Parent_eval(true);
+		priority_list[parent_pt->get_Priolist_index()].set_Parent_eval(true);
+
+		// Keep track of the closest cell to the end point for the partial path 
+		if (parent_pt->get_Hcost() < best_hcost) {
+			best_hcost = parent_pt->get_Hcost();
+			best_cell_ID = parent_pt->get_ID();
+		}
+
+		/* NOTES: 
+		-	When the end cell (target or whatever) is met, the while condition is checked. Therefore, the end cell is actually not calculated.
+			But the new parent (which will be the end cell) knows the parent it comes from, i.e. the path, so is fine. Just weird for plotting i guess
+		-   NEED A FUNCTION TO CLEAR THE PRIORITY LIST OF REDUNDENT CELLS to avoid excess looping over list*/
+
+		// Expansion counter and search limits (only checked every check_interval expansions as now() is not free) 
+		outcome.expansions += 1;
+		if (limits.check_interval <= 1 || outcome.expansions % limits.check_interval == 0) {
+			Search_result stop_reason;
+			if (parent_pt->get_isEnd() == false && check_search_limits(limits, outcome.expansions, stop_reason) == true) {
+				outcome.result = stop_reason;
+				break;
+			}
+		}
+
+#if DEBUG==0
+		// Iteration logger 
+		std::cout << "Iteration: " << outcome.expansions << "\n\n";
+
+		/* "Real time" plot grid using ASCII characters for console.. need a better plotter */
+		for (size_t i_plot = 0; i_plot < row_PT; i_plot++) {
+
+			std::cout << "| ";
+
+			for (size_t j_plot = 0; j_plot < col_PT; j_plot++) {
+
+				// Plot start and end poitns with them beign a parent at one point (i.e. the algorithm works, this is just to check for bugs) 
+				if ((state(i_plot, j_plot).get_isStart() == true && state(i_plot, j_plot).get_Parent_eval() == true) || (state(i_plot, j_plot).get_isEnd() == true && state(i_plot, j_plot).get_Parent_eval() == true)) {
+					std::cout << "@ "; 
+				}
+				// Plot start and end points (If not the above then there is a problem)
+				else if (state(i_plot, j_plot).get_isStart() == true || state(i_plot, j_plot).get_isEnd() == true) {
+					std::cout << "% ";
+				}
+				// If cell is a parent
+				else if (state(i_plot, j_plot).get_Parent_eval() == true) {
+					std::cout << "P ";
+				}
+				// If cell has been evaluated 
+				else if (state(i_plot, j_plot).get_On_priolist() == true) {
+					std::cout << "A ";
+				}
+				else if (state(i_plot, j_plot).get_Obstacle() == true) {
+					std::cout << (char)254u << " ";
+				}
+
+				else {
+					std::cout << ". ";
+				}
+			}
+			// Next row 
+			std::cout << "|\n";
+		}
+#endif
+
+	} // End of while loop for finding target/end point of algorithm. 
+
+	/* -------------------------- Establish path from cell IDs -------------------------------------- */
+	// Full path if the end point was reached, else the best partial path to the closest cell found 
+	if (parent_pt->get_isEnd() == true) {
+		outcome.result = Search_result::found;
+		best_cell_ID = parent_pt->get_ID();
+	}
+	backtrack_path(state, best_cell_ID, outcome.path_cell_IDs);
+
+	return outcome;
+}
@@ -5,6 +5,8 @@
 /* Include external modules */
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <chrono>
 
 /* Include library API */
 #include "SL_Comptime_Interface.h"
@@ -12,6 +14,11 @@
 
 /* Include any internal APIs*/
 #include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "Component_labels.h"
+#include "Landmark_heuristic.h"
+#include "Map_snapshot.h"
+#include "Search_state.h"
 
 /* Macro for debugging
 - DEBUG 0 = Debug -> Real time printing of pathfinding, boundary condition cell output,
@@ -19,14 +26,59 @@
 */
 #define DEBUG 1
 
+/* Typed outcome of a search */
+enum class Search_result {
+	found,					// Target cell was reached, path is the full path
+	unreachable,				// Priority list ran out of cells before the target was reached
+	budget_exceeded,			// Deadline or node-expansion budget was hit
+	cancelled				// Cancellation token was raised by another thread
+};
+
+/* Limits for a single search so one bad query cannot stall the calling thread.
+- The limits are only checked every check_interval expansions to keep the main loop cheap.
+- max_expansions = 0 means no expansion budget, cancel_token = nullptr means not cancellable. */
+struct Search_limits {
+	std::chrono::steady_clock::time_point	deadline	= std::chrono::steady_clock::time_point::max();
+	size_t					max_expansions	= 0;
+	const std::atomic<bool>*		cancel_token	= nullptr;
+	size_t					check_interval	= 64;
+};
+
+/* Result of a search. If the target was not reached, the path is the best partial path 
+(start -> the closed cell with the lowest hcost). Path is stored start -> end as cell IDs. */
+struct Search_outcome {
+	Search_result		result		= Search_result::unreachable;
+	std::vector<int>	path_cell_IDs;
+	size_t			expansions	= 0;
+};
+
+/* Boundary value of a cell (0 if not a boundary cell, see B_IDs in grid_generation) */
+int boundary_pt_value(size_t i, size_t j, size_t row_PT, size_t col_PT);
+
 /* Grid generation function*/
-void grid_generation(RMF::DYN_C2D<Cell_ds>& grid, size_t row_PT, size_t col_PT, float spacing); 
+void grid_generation(Cell_grid& grid, size_t row_PT, size_t col_PT, float spacing); 
 
 /* Obstacle generation */
-void obstacle_generation(RMF::DYN_C2D<Cell_ds>& grid, int row_PT, int col_PT, int no_of_objects);
+void obstacle_generation(Cell_grid& grid, int row_PT, int col_PT, int no_of_objects);
 
 /* Choosing correct parent cell based on F and G costs */
 std::vector<Cell_ds> min_FHcost(std::vector<Cell_ds>& priority_list, Cell_ds*& parent_pt, Cell_ds& pt_A);
 
-/* A* algorithm implementation */
-void A_star_algorithm(size_t(&loop_index)[4], RMF::DYN_C2D<Cell_ds>& grid, std::vector<Cell_ds>& priority_list, size_t& priolist_index, Cell_ds*& parent_pt, Cell_ds& pt_B, const size_t& p_col, const size_t& p_row, const int& diag_movement, const int& adj_movement);
+/* A* algorithm implementation (landmarks can be nullptr for the distance-only heuristic) */
+void A_star_algorithm(size_t(&loop_index)[4], Search_state& state, std::vector<Cell_ds>& priority_list, size_t& priolist_index, Cell_ds*& parent_pt, Cell_ds& pt_B, const size_t& p_col, const size_t& p_row, const int& diag_movement, const int& adj_movement, const Landmark_heuristic* landmarks);
+
+/* Check search limits (deadline, expansion budget and cancellation), returns true if the search must stop and sets stop_reason 
+(cancelled or budget_exceeded), stop_reason is not changed if the search may continue */
+bool check_search_limits(const Search_limits& limits, size_t expansions, Search_result& stop_reason);
+
+/* Backtrack the path from a cell to the start cell using the from cell IDs, stored start -> end */
+void backtrack_path(Search_state& state, int end_cell_ID, std::vector<int>& path_cell_IDs);
+
+/* Full A* search from the start to the end cell of the search state within the search limits
+- All per-search data is kept in the state (one Search_state per search), the grid is only read, so searches on the same grid 
+  can run concurrently. The state holds the costs and flags of the touched cells afterwards (e.g. for plotting).
+- Obstacles are read from the state's map snapshot if it has one, else from the grid 
+- components can be nullptr, else start and end points in different components are rejected before searching 
+- landmarks can be nullptr, else the heuristic is the max of the landmark bound and the distance-only heuristic 
+- components and landmarks built from another map version than the state's snapshot are not used */
+Search_outcome A_star_search(Search_state& state, size_t row_PT, size_t col_PT, const int& diag_movement, const int& adj_movement, const Search_limits& limits, const Component_labels* components, const Landmark_heuristic* landmarks);
@@ -77,6 +77,7 @@ public:
 	void	set_Boundary_pt_val(int val) 	{ boundary_pt_val = val;  }
 	int	get_Boundary_pt_val() 		{ return boundary_pt_val;  }
 	void	set_Obstacle() 			{ obstacle_pt = true; }
+	void	clear_Obstacle() 		{ obstacle_pt = false; }
 	bool	get_Obstacle()		 	{ return obstacle_pt; }
 
 	void	set_On_priolist() 		{ on_priolist = true;  }
@@ -154,6 +155,13 @@ public:
 		return heurcost; 
 	}
 
+	/* Raise the heuristic cost to a better informed lower bound (e.g. landmark bound), the larger admissible estimate is kept */
+	void raise_heurcost(int lower_bound) {
+		if (lower_bound > heurcost) {
+			heurcost = lower_bound;
+		}
+	}
+
 	int generate_fcost() {
 		fcost = gcost + heurcost;
 		return fcost;
@@ -0,0 +1,25 @@
+#pragma once
+
+/* Grid storage layout used by the A* functions 
+- GRID_LAYOUT 0 = RMF::DYN_C2D, row-major contiguous storage
+- GRID_LAYOUT 1 = Tiled_C2D, 8x8 tiles with NUMA first-touch allocation (better cache/TLB locality on very large maps) 
+- GRID_LAYOUT 2 = Paged_grid, tiles streamed from disk through an LRU tile cache (maps larger than RAM, call open() first) 
+*/
+#define GRID_LAYOUT 0
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Tiled_C2D.h"
+#include "Paged_grid.h"
+
+#if GRID_LAYOUT==1
+typedef Tiled_C2D<Cell_ds, 8>	Cell_grid;
+#elif GRID_LAYOUT==2
+typedef Paged_grid		Cell_grid;
+#else
+typedef RMF::DYN_C2D<Cell_ds>	Cell_grid;
+#endif
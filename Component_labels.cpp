@@ -0,0 +1,417 @@
+/* Implementation for connected component labelling */
+
+#include "Component_labels.h"
+
+#include <thread>
+
+/* Union-find root with path halving */
+size_t Component_labels::find_root(size_t cell) {
+
+	while (uf_parent[cell] != cell) {
+		uf_parent[cell] = uf_parent[uf_parent[cell]];
+		cell = uf_parent[cell];
+	}
+	return cell;
+}
+
+/* Union two cells, the root with the smaller index becomes the parent */
+void Component_labels::unite(size_t cell_a, size_t cell_b) {
+
+	size_t root_a = find_root(cell_a);
+	size_t root_b = find_root(cell_b);
+
+	if (root_a < root_b) {
+		uf_parent[root_b] = root_a;
+	}
+	else if (root_b < root_a) {
+		uf_parent[root_a] = root_b;
+	}
+}
+
+/* Union all passable cells of rows [row_begin, row_end) with their neighbours inside the band */
+template <typename Obstacle_fn>
+void Component_labels::label_band(const Obstacle_fn& is_obstacle, size_t row_begin, size_t row_end) {
+
+	for (size_t i = row_begin; i < row_end; i++) {
+		for (size_t j = 0; j < cols; j++) {
+
+			if (is_obstacle(i, j) == true) {
+				continue;
+			}
+			size_t cell = (i * cols) + j;
+
+			// Only look at the already visited neighbours (left, and the three below), the rest are done when they are visited
+			if (j > 0 && is_obstacle(i, j - 1) == false) {
+				unite(cell, cell - 1);
+			}
+			if (i > row_begin) {
+				if (j > 0 && is_obstacle(i - 1, j - 1) == false) {
+					unite(cell, cell - cols - 1);
+				}
+				if (is_obstacle(i - 1, j) == false) {
+					unite(cell, cell - cols);
+				}
+				if (j < cols - 1 && is_obstacle(i - 1, j + 1) == false) {
+					unite(cell, cell - cols + 1);
+				}
+			}
+		}
+	}
+}
+
+/* Label all passable cells (is_obstacle(i, j) gives the obstacle flags) using n_threads bands */
+template <typename Obstacle_fn>
+void Component_labels::label_cells(const Obstacle_fn& is_obstacle, size_t row_PT, size_t col_PT, size_t n_threads) {
+
+	rows = row_PT;
+	cols = col_PT;
+	size_t n_cells = rows * cols;
+
+	// Nothing to label on an empty grid (also keeps the band size below from dividing by zero threads)
+	if (n_cells == 0) {
+		label.clear();
+		component_size.clear();
+		uf_parent.clear();
+		return;
+	}
+
+	// Each cell starts as its own root 
+	uf_parent.resize(n_cells);
+	for (size_t c = 0; c < n_cells; c++) {
+		uf_parent[c] = c;
+	}
+
+	// Split the rows into bands, one per thread. Unions inside a band only touch cells inside that band so no locking is needed
+	if (n_threads < 1) {
+		n_threads = 1;
+	}
+	if (n_threads > rows) {
+		n_threads = rows;
+	}
+	size_t band_rows = (rows + n_threads - 1) / n_threads;
+
+	std::vector<std::thread> workers;
+	workers.reserve(n_threads);
+	for (size_t row_begin = 0; row_begin < rows; row_begin += band_rows) {
+		size_t row_end = (row_begin + band_rows < rows) ? row_begin + band_rows : rows;
+		workers.emplace_back(&Component_labels::label_band<Obstacle_fn>, this, std::cref(is_obstacle), row_begin, row_end);
+	}
+	for (size_t t = 0; t < workers.size(); t++) {
+		workers[t].join();
+	}
+
+	// Merge the seams between bands (first row of each band with the last row of the band below) 
+	for (size_t i = band_rows; i < rows; i += band_rows) {
+		for (size_t j = 0; j < cols; j++) {
+
+			if (is_obstacle(i, j) == true) {
+				continue;
+			}
+			size_t cell = (i * cols) + j;
+
+			if (j > 0 && is_obstacle(i - 1, j - 1) == false) {
+				unite(cell, cell - cols - 1);
+			}
+			if (is_obstacle(i - 1, j) == false) {
+				unite(cell, cell - cols);
+			}
+			if (j < cols - 1 && is_obstacle(i - 1, j + 1) == false) {
+				unite(cell, cell - cols + 1);
+			}
+		}
+	}
+
+	// Flatten roots into compact labels 0 -> N components
+	label.assign(n_cells, -1);
+	component_size.clear();
+	std::vector<int> root_label(n_cells, -1);
+
+	for (size_t c = 0; c < n_cells; c++) {
+
+		if (is_obstacle(c / cols, c % cols) == true) {
+			continue;
+		}
+		size_t root = find_root(c);
+		if (root_label[root] == -1) {
+			root_label[root] = (int)component_size.size();
+			component_size.push_back(0);
+		}
+		label[c] = root_label[root];
+		component_size[label[c]] += 1;
+	}
+
+	// Union-find is not needed for the incremental updates
+	uf_parent.clear();
+	uf_parent.shrink_to_fit();
+}
+
+/* Label all passable cells of the grid using n_threads bands */
+void Component_labels::label_components(Cell_grid& grid, size_t row_PT, size_t col_PT, size_t n_threads) {
+
+#if GRID_LAYOUT==2
+	n_threads = 1;		// Paged grid tile cache is not thread safe
+#endif
+	label_cells([&grid](size_t i, size_t j) { return grid(i, j).get_Obstacle(); }, row_PT, col_PT, n_threads);
+	map_version = 0;
+}
+
+/* Label all passable cells of a map snapshot using n_threads bands */
+void Component_labels::label_components(const Map_snapshot& map, size_t n_threads) {
+
+	label_cells([&map](size_t i, size_t j) { return map.get_Obstacle(i, j); }, map.get_Rows(), map.get_Cols(), n_threads);
+	map_version = map.get_Version();
+}
+
+/* O(1) same component check, obstacles are never in a component */
+bool Component_labels::same_component(size_t contig_a, size_t contig_b) const {
+	return label[contig_a] != -1 && label[contig_a] == label[contig_b];
+}
+
+/* Number of non-empty components */
+size_t Component_labels::get_No_of_components() const {
+
+	size_t no_of_components = 0;
+	for (size_t l = 0; l < component_size.size(); l++) {
+		if (component_size[l] > 0) {
+			no_of_components += 1;
+		}
+	}
+	return no_of_components;
+}
+
+/* Flood fill from a cell over cells with old_label and give them new_label */
+size_t Component_labels::flood_relabel(size_t start_cell, int old_label, int new_label) {
+
+	std::vector<size_t> stack;
+	stack.push_back(start_cell);
+	label[start_cell] = new_label;
+	size_t no_relabelled = 1;
+
+	while (stack.empty() == false) {
+
+		size_t cell = stack.back();
+		stack.pop_back();
+
+		// Casting to int as the neighbour offsets can be negative 
+		int row = (int)(cell / cols);
+		int col = (int)(cell % cols);
+
+		for (int di = -1; di <= 1; di++) {
+			for (int dj = -1; dj <= 1; dj++) {
+
+				int n_row = row + di;
+				int n_col = col + dj;
+				if (n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+					continue;
+				}
+				size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+				if (label[n_cell] == old_label) {
+					label[n_cell] = new_label;
+					no_relabelled += 1;
+					stack.push_back(n_cell);
+				}
+			}
+		}
+	}
+	return no_relabelled;
+}
+
+/* Clear an obstacle on the grid and merge the neighbouring components */
+void Component_labels::clear_Obstacle_cell(Cell_grid& grid, size_t row, size_t col) {
+
+	if (grid(row, col).get_Obstacle() == false) {
+		return;
+	}
+	grid(row, col).clear_Obstacle();
+	if (path_cache != nullptr) {
+		path_cache->invalidate();		// Cached paths may no longer be the shortest
+	}
+
+	// Labels now describe the edited grid, which no snapshot has
+	map_version = edited_grid_version;
+	clear_Obstacle_label(row, col);
+}
+
+/* Set an obstacle on the grid and split the component if the cell was the only connection */
+void Component_labels::set_Obstacle_cell(Cell_grid& grid, size_t row, size_t col) {
+
+	if (grid(row, col).get_Obstacle() == true) {
+		return;
+	}
+	grid(row, col).set_Obstacle();
+	if (path_cache != nullptr) {
+		path_cache->invalidate();		// Cached paths may run through the cell
+	}
+
+	map_version = edited_grid_version;
+	set_Obstacle_label(row, col);
+}
+
+/* Update the labels with the edits of a published snapshot */
+void Component_labels::apply_edits(const std::vector<Map_edit>& edits, uint64_t new_map_version) {
+
+	if (map_version == edited_grid_version || map_version + 1 != new_map_version) {
+		std::cout << "Error. Labels at map version " << map_version << " cannot take the edits of version " << new_map_version 
+			<< ", label the snapshot again.\n";
+		exit(-1);
+	}
+
+	// Edits are applied in order (a later edit of the same cell wins, as in the snapshot)
+	for (size_t e = 0; e < edits.size(); e++) {
+		if (edits[e].row >= rows || edits[e].col >= cols) {
+			continue;		// Rejected by publish
+		}
+		size_t cell = (edits[e].row * cols) + edits[e].col;
+		if (edits[e].obstacle == true && label[cell] != -1) {
+			set_Obstacle_label(edits[e].row, edits[e].col);
+		}
+		else if (edits[e].obstacle == false && label[cell] == -1) {
+			clear_Obstacle_label(edits[e].row, edits[e].col);
+		}
+	}
+	map_version = new_map_version;
+}
+
+/* Passable cell, merge the neighbouring components */
+void Component_labels::clear_Obstacle_label(size_t row, size_t col) {
+
+	size_t cell = (row * cols) + col;
+
+	// Find the largest neighbouring component to keep 
+	int keep_label = -1;
+	for (int di = -1; di <= 1; di++) {
+		for (int dj = -1; dj <= 1; dj++) {
+			int n_row = (int)row + di;
+			int n_col = (int)col + dj;
+			if (n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+				continue;
+			}
+			int n_label = label[((size_t)n_row * cols) + (size_t)n_col];
+			if (n_label != -1 && (keep_label == -1 || component_size[n_label] > component_size[keep_label])) {
+				keep_label = n_label;
+			}
+		}
+	}
+
+	// Isolated cell is a new component 
+	if (keep_label == -1) {
+		label[cell] = (int)component_size.size();
+		component_size.push_back(1);
+		return;
+	}
+
+	// Relabel the other neighbouring components into the kept one (cost is the size of the smaller components)
+	for (int di = -1; di <= 1; di++) {
+		for (int dj = -1; dj <= 1; dj++) {
+			int n_row = (int)row + di;
+			int n_col = (int)col + dj;
+			if (n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+				continue;
+			}
+			size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+			int n_label = label[n_cell];
+			if (n_label != -1 && n_label != keep_label) {
+				component_size[keep_label] += flood_relabel(n_cell, n_label, keep_label);
+				component_size[n_label] = 0;
+			}
+		}
+	}
+
+	label[cell] = keep_label;
+	component_size[keep_label] += 1;
+}
+
+/* Obstacle cell, split the component if the cell was the only connection */
+void Component_labels::set_Obstacle_label(size_t row, size_t col) {
+
+	size_t cell = (row * cols) + col;
+	int old_label = label[cell];
+	label[cell] = -1;
+	component_size[old_label] -= 1;
+
+	// Passable neighbours (offsets kept for the local connectivity check)
+	int	n_offset[8][2];
+	size_t	n_cells[8];
+	int	no_of_neighbours = 0;
+	for (int di = -1; di <= 1; di++) {
+		for (int dj = -1; dj <= 1; dj++) {
+			int n_row = (int)row + di;
+			int n_col = (int)col + dj;
+			if ((di == 0 && dj == 0) || n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+				continue;
+			}
+			size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+			if (label[n_cell] != -1) {
+				n_offset[no_of_neighbours][0] = di;
+				n_offset[no_of_neighbours][1] = dj;
+				n_cells[no_of_neighbours] = n_cell;
+				no_of_neighbours += 1;
+			}
+		}
+	}
+
+	// Group the neighbours which are connected to each other without going through the removed cell (8-connected in the 3x3 ring)
+	int	group[8];
+	int	no_of_groups = 0;
+	for (int n = 0; n < no_of_neighbours; n++) {
+		group[n] = -1;
+	}
+	for (int n = 0; n < no_of_neighbours; n++) {
+		if (group[n] != -1) {
+			continue;
+		}
+		group[n] = no_of_groups;
+		
+		// Tiny flood over at most 8 neighbours
+		bool grown = true;
+		while (grown == true) {
+			grown = false;
+			for (int a = 0; a < no_of_neighbours; a++) {
+				if (group[a] != no_of_groups) {
+					continue;
+				}
+				for (int b = 0; b < no_of_neighbours; b++) {
+					if (group[b] == -1 && RMF::abs(n_offset[a][0] - n_offset[b][0]) <= 1 && RMF::abs(n_offset[a][1] - n_offset[b][1]) <= 1) {
+						group[b] = no_of_groups;
+						grown = true;
+					}
+				}
+			}
+		}
+		no_of_groups += 1;
+	}
+
+	// Neighbours are connected locally so the component cannot have been split 
+	if (no_of_groups <= 1) {
+		return;
+	}
+
+	// Flood fill a group with a new label until only one group still has the old label (that one keeps it). 
+	// If a flood reaches another group, they were connected around the removed cell and no split happened for them.
+	while (true) {
+
+		int	first_old_neighbour	= -1;
+		bool	split			= false;
+		for (int n = 0; n < no_of_neighbours; n++) {
+			if (label[n_cells[n]] != old_label) {
+				continue;
+			}
+			if (first_old_neighbour == -1) {
+				first_old_neighbour = n;
+			}
+			else if (group[n] != group[first_old_neighbour]) {
+				split = true;
+				break;
+			}
+		}
+		if (split == false) {
+			break;
+		}
+
+		int new_label = (int)component_size.size();
+		component_size.push_back(0);
+		size_t no_relabelled = flood_relabel(n_cells[first_old_neighbour], old_label, new_label);
+		component_size[new_label] = no_relabelled;
+		component_size[old_label] -= no_relabelled;
+	}
+}
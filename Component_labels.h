@@ -0,0 +1,93 @@
+#pragma once
+
+/* Connected component labelling of passable cells.
+- Cells are 8-connected (same neighbours as the A* neighbour loop) and obstacles are not part of any component.
+- Start and end points in different components means the end point is unreachable, which is checked in O(1) 
+  instead of the search exhausting every reachable cell first.
+- Labelling is done with union-find, in parallel over bands of rows (tiles), and the seams between bands are merged after. 
+- Toggling single cells updates the labels incrementally. 
+- The labels record the Map_snapshot version they were built from (0 when built from the grid, the version a Map_store built 
+  from that grid starts at). A_star_search does not use them with a snapshot of another version. 
+- Once a Map_store exists its snapshots hold the obstacles, so cells are changed with Map_store::publish and the labels follow 
+  with apply_edits(edits, new version) (or are labelled again from the new snapshot). Toggling grid cells with 
+  set_Obstacle_cell/clear_Obstacle_cell is for maps without a Map_store: the labels then describe the edited grid 
+  (edited_grid_version) and are only used by searches without a snapshot. 
+- Labels are not thread safe for updates, do not update labels which searches are using. 
+- Labels are kept in RAM for every cell (4 bytes, plus 8 bytes per cell while labelling), so they are not built for maps larger 
+  than RAM (GRID_LAYOUT 2, see main). */
+
+/* Include external modules */
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "Map_snapshot.h"
+#include "Path_cache.h"
+
+class Component_labels {
+
+private:
+	size_t			rows, cols;
+	std::vector<int>	label;				// Component label of each cell (contiguous index), -1 if the cell is an obstacle
+	std::vector<size_t>	component_size;			// Number of cells with each label (0 if the label has been merged or split away)
+	std::vector<size_t>	uf_parent;			// Union-find parent of each cell, only used while labelling
+	Path_cache*		path_cache;			// Invalidated when a cell is toggled (nullptr if none)
+	uint64_t		map_version;			// Snapshot version the labels were built from
+
+	/* Union-find helpers (path halving, root with the smaller index wins so bands do not write outside of themselves) */
+	size_t	find_root(size_t cell);
+	void	unite(size_t cell_a, size_t cell_b);
+
+	/* Union all passable cells of rows [row_begin, row_end) with their neighbours inside the band */
+	template <typename Obstacle_fn>
+	void	label_band(const Obstacle_fn& is_obstacle, size_t row_begin, size_t row_end);
+
+	/* Label all passable cells, is_obstacle(i, j) gives the obstacle flags (grid or snapshot) */
+	template <typename Obstacle_fn>
+	void	label_cells(const Obstacle_fn& is_obstacle, size_t row_PT, size_t col_PT, size_t n_threads);
+
+	/* Flood fill from a cell over cells with old_label and give them new_label, returns the number of cells relabelled */
+	size_t	flood_relabel(size_t start_cell, int old_label, int new_label);
+
+	/* Incremental label updates for a cell which became an obstacle or passable (the labels are the only obstacle flags used) */
+	void	set_Obstacle_label(size_t row, size_t col);
+	void	clear_Obstacle_label(size_t row, size_t col);
+
+public:
+
+	/* Map version of labels updated by grid toggles, never the version of a snapshot */
+	static constexpr uint64_t	edited_grid_version	= UINT64_MAX;
+
+	/* Constructors and destructors */
+	Component_labels() : rows(0), cols(0), path_cache(nullptr), map_version(0) {}
+
+	/* Label all passable cells of the grid (map version 0) or of a map snapshot (its version) using n_threads bands */
+	void	label_components(Cell_grid& grid, size_t row_PT, size_t col_PT, size_t n_threads);
+	void	label_components(const Map_snapshot& map, size_t n_threads);
+
+	/* O(1) queries */
+	bool	same_component(size_t contig_a, size_t contig_b) const;
+	int	get_Label(size_t contig) const			{ return label[contig]; }
+	size_t	get_No_of_components() const;
+	uint64_t	get_Map_version() const			{ return map_version; }
+
+	/* Toggle a single cell on the grid and update the labels (maps without a Map_store, the labels move to edited_grid_version)
+	- Clearing an obstacle merges the neighbouring components (relabels all but the largest)
+	- Setting an obstacle can split a component, which is only checked (flood filled) if its neighbours are not connected locally */
+	void	set_Obstacle_cell(Cell_grid& grid, size_t row, size_t col);
+	void	clear_Obstacle_cell(Cell_grid& grid, size_t row, size_t col);
+
+	/* Update the labels with the edits of a Map_store::publish which made new_map_version (the labels must be at the version 
+	before it), the labels are then at new_map_version */
+	void	apply_edits(const std::vector<Map_edit>& edits, uint64_t new_map_version);
+
+	/* Path cache to invalidate when a grid cell is toggled */
+	void	set_Path_cache(Path_cache* cache)		{ path_cache = cache; }
+};
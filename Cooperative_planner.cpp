@@ -0,0 +1,402 @@
+/* Implementation for cooperative multi-agent planning (WHCA*) */
+
+#include "Cooperative_planner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <utility>
+
+/* ---------------------------------------- Reservation table ---------------------------------------- */
+
+/* Agent holding a cell at a time */
+int Reservation_table::get_Holder(size_t cell, uint64_t time) const {
+
+	if (time < now || time > now + get_Window()) {
+		return -1;
+	}
+	const std::unordered_map<size_t, int>& time_slot = slot(time);
+	std::unordered_map<size_t, int>::const_iterator it = time_slot.find(cell);
+	return (it == time_slot.end()) ? -1 : it->second;
+}
+
+/* Reserve a cell at a time */
+void Reservation_table::reserve(size_t cell, uint64_t time, int agent) {
+
+	if (time < now || time > now + get_Window()) {
+		return;
+	}
+	slot(time)[cell] = agent;
+}
+
+/* Release a cell at a time (only if the agent holds it) */
+void Reservation_table::release(size_t cell, uint64_t time, int agent) {
+
+	if (time < now || time > now + get_Window()) {
+		return;
+	}
+	std::unordered_map<size_t, int>& time_slot = slot(time);
+	std::unordered_map<size_t, int>::iterator it = time_slot.find(cell);
+	if (it != time_slot.end() && it->second == agent) {
+		time_slot.erase(it);
+	}
+}
+
+/* Move to the next time step */
+void Reservation_table::advance() {
+	slot(now).clear();
+	now += 1;
+}
+
+/* ---------------------------------------- Cooperative planner ---------------------------------------- */
+
+Cooperative_planner::Cooperative_planner(Cell_grid& grid, size_t row_PT, size_t col_PT, int diag_cost, int adj_cost, size_t window_size, size_t replan_ticks) :
+	rows(row_PT), cols(col_PT), n_cells(row_PT * col_PT),
+	diag_movement(diag_cost), adj_movement(adj_cost),
+	window(window_size < 2 ? 2 : window_size), replan_interval(replan_ticks),
+	reservations(window_size < 2 ? 2 : window_size),
+	agents_planned(0), failed_plans(0), collisions(0), planning_ms(0.0) {
+
+	// Re-plan before the reserved window runs out, so at a replan tick every agent still holds its next step
+	if (replan_interval < 1 || replan_interval >= window) {
+		replan_interval = window - 1;
+	}
+
+	// Read the obstacle flags once, the planner does not use the per-search state of the cells
+	passable.assign(n_cells, 0);
+	for (size_t c = 0; c < n_cells; c++) {
+		passable[c] = (grid(c).get_Obstacle() == false) ? 1 : 0;
+	}
+}
+
+/* Add an agent */
+size_t Cooperative_planner::add_agent(size_t start_contig, size_t goal_contig) {
+
+	if (start_contig >= n_cells || goal_contig >= n_cells || passable[start_contig] == 0) {
+		std::cout << "Error. Agent start cell " << start_contig << " is outside of the map or an obstacle.\n";
+		exit(-1);
+	}
+	int holder = reservations.get_Holder(start_contig, reservations.get_Now());
+	if (holder != -1) {
+		std::cout << "Error. Agent start cell " << start_contig << " is taken by agent " << holder << ".\n";
+		exit(-1);
+	}
+
+	Agent agent;
+	agent.position	= start_contig;
+	agent.goal	= goal_contig;
+
+	// Agents with the same goal share one goal search
+	std::unordered_map<size_t, std::shared_ptr<Goal_search>>::iterator it = goal_searches.find(goal_contig);
+	if (it == goal_searches.end()) {
+		std::shared_ptr<Goal_search> search = std::make_shared<Goal_search>();
+		search->goal	= goal_contig;
+		search->target	= start_contig;
+		if (passable[goal_contig] == 1) {
+			search->entries[goal_contig].gcost = 0;
+			search->open_list.push(Goal_search::Queue_item(octile_distance(goal_contig, start_contig), 0, goal_contig));
+		}
+		it = goal_searches.emplace(goal_contig, search).first;
+	}
+	agent.goal_search = it->second;
+	agents.push_back(agent);
+
+	// Hold the start cell so other agents do not plan into it before this agent has planned (all agents re-plan on the next 
+	// tick, as this one has no path yet) 
+	hold_position((int)(agents.size() - 1));
+
+	return agents.size() - 1;
+}
+
+/* Octile distance between two cells */
+uint64_t Cooperative_planner::octile_distance(size_t cell_a, size_t cell_b) const {
+
+	size_t d_row = (cell_a / cols > cell_b / cols) ? (cell_a / cols) - (cell_b / cols) : (cell_b / cols) - (cell_a / cols);
+	size_t d_col = (cell_a % cols > cell_b % cols) ? (cell_a % cols) - (cell_b % cols) : (cell_b % cols) - (cell_a % cols);
+	size_t diag = std::min(d_row, d_col);
+
+	// A diagonal move never costs more than two adjacent moves in the estimate, else it would not be consistent
+	uint64_t diag_cost = std::min((uint64_t)diag_movement, 2 * (uint64_t)adj_movement);
+	return (diag * diag_cost) + ((std::max(d_row, d_col) - diag) * (uint64_t)adj_movement);
+}
+
+/* True distance from a cell to the goal, resuming the reverse search until the cell is closed */
+uint32_t Cooperative_planner::goal_distance(Goal_search& search, size_t cell) {
+
+	std::unordered_map<size_t, Goal_search::Entry>::iterator it = search.entries.find(cell);
+	if (it != search.entries.end() && it->second.closed == true) {
+		return it->second.gcost;
+	}
+
+	while (search.open_list.empty() == false) {
+
+		Goal_search::Queue_item item = search.open_list.top();
+		search.open_list.pop();
+		size_t current = std::get<2>(item);
+		Goal_search::Entry& entry = search.entries[current];
+		if (entry.closed == true || std::get<1>(item) > entry.gcost) {
+			continue;		// Stale queue entry
+		}
+		entry.closed = true;
+
+		// Casting to int as the neighbour offsets can be negative 
+		int row = (int)(current / cols);
+		int col = (int)(current % cols);
+
+		for (int di = -1; di <= 1; di++) {
+			for (int dj = -1; dj <= 1; dj++) {
+				int n_row = row + di;
+				int n_col = col + dj;
+				if ((di == 0 && dj == 0) || n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+					continue;
+				}
+				size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+				if (passable[n_cell] == 0) {
+					continue;
+				}
+				uint32_t movement = (di != 0 && dj != 0) ? (uint32_t)diag_movement : (uint32_t)adj_movement;
+				Goal_search::Entry& n_entry = search.entries[n_cell];
+				if (n_entry.closed == false && entry.gcost + movement < n_entry.gcost) {
+					n_entry.gcost = entry.gcost + movement;
+					search.open_list.push(Goal_search::Queue_item(n_entry.gcost + octile_distance(n_cell, search.target), n_entry.gcost, n_cell));
+				}
+			}
+		}
+
+		if (current == cell) {
+			return entry.gcost;
+		}
+	}
+
+	// Open list is empty, the cell cannot reach the goal
+	return 0xFFFFFFFFu;
+}
+
+/* Hold the agent's cell from now until the next replan tick */
+bool Cooperative_planner::hold_position(int agent_index) {
+
+	Agent& agent = agents[agent_index];
+	uint64_t now = reservations.get_Now();
+	bool held = true;
+
+	for (uint64_t time = now; time <= now + replan_interval; time++) {
+		int holder = reservations.get_Holder(agent.position, time);
+		if (holder == -1 || holder == agent_index) {
+			reservations.reserve(agent.position, time, agent_index);
+		}
+		else {
+			held = false;
+		}
+	}
+	return held;
+}
+
+/* Release the agent's reservations from now on */
+void Cooperative_planner::release_agent(int agent_index) {
+
+	Agent& agent = agents[agent_index];
+	uint64_t now = reservations.get_Now();
+
+	for (size_t d = 0; d < agent.path.size(); d++) {
+		reservations.release(agent.path[d], now + d, agent_index);
+	}
+	for (uint64_t time = now; time <= now + replan_interval; time++) {
+		reservations.release(agent.position, time, agent_index);
+	}
+}
+
+/* Space-time A* for one agent over the window */
+void Cooperative_planner::plan_agent(int agent_index) {
+
+	Agent& agent = agents[agent_index];
+	Goal_search& goal_search = *agent.goal_search;
+	uint64_t now = reservations.get_Now();
+
+	/* Search node in (cell, time) space, time is the depth from now */
+	struct Node {
+		size_t		cell;
+		uint32_t	depth;
+		uint64_t	gcost;
+		int		parent;
+	};
+	std::vector<Node> nodes;
+
+	typedef std::pair<uint64_t, int> Queue_item;			// (fcost, node index)
+	std::priority_queue<Queue_item, std::vector<Queue_item>, std::greater<Queue_item>> open_list;
+	std::unordered_map<uint64_t, uint64_t> best_gcost;		// (depth * n_cells + cell) -> lowest gcost found
+
+	// Beyond the window the estimate is the true distance ignoring other agents (unreachable goal counts as far away)
+	const uint64_t unreachable_h = (uint64_t)n_cells * (uint64_t)(diag_movement + adj_movement);
+
+	nodes.push_back(Node{ agent.position, 0, 0, -1 });
+	best_gcost[agent.position] = 0;
+	uint32_t start_h = goal_distance(goal_search, agent.position);
+	open_list.push(Queue_item((start_h == 0xFFFFFFFFu) ? unreachable_h : start_h, 0));
+
+	// Deepest node popped, the fallback if the end of the window cannot be reached
+	int deepest_node = 0;
+
+	while (open_list.empty() == false) {
+
+		int node_index = open_list.top().second;
+		open_list.pop();
+		Node node = nodes[node_index];
+
+		uint64_t key = ((uint64_t)node.depth * n_cells) + node.cell;
+		if (node.gcost > best_gcost[key]) {
+			continue;		// Stale queue entry
+		}
+		if (node.depth > nodes[deepest_node].depth) {
+			deepest_node = node_index;
+		}
+
+		// Reached the end of the window
+		if (node.depth == window) {
+			break;
+		}
+
+		int row = (int)(node.cell / cols);
+		int col = (int)(node.cell % cols);
+		uint64_t time = now + node.depth;
+
+		// 8 moves and waiting in place (di = dj = 0)
+		for (int di = -1; di <= 1; di++) {
+			for (int dj = -1; dj <= 1; dj++) {
+
+				int n_row = row + di;
+				int n_col = col + dj;
+				if (n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+					continue;
+				}
+				size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+				if (passable[n_cell] == 0) {
+					continue;
+				}
+
+				// Vertex conflict, another agent holds the cell at the next time step
+				int holder = reservations.get_Holder(n_cell, time + 1);
+				if (holder != -1 && holder != agent_index) {
+					continue;
+				}
+				// Swap conflict, the agent in the next cell is moving into this cell
+				if (n_cell != node.cell) {
+					int swap_holder = reservations.get_Holder(n_cell, time);
+					if (swap_holder != -1 && swap_holder != agent_index && reservations.get_Holder(node.cell, time + 1) == swap_holder) {
+						continue;
+					}
+				}
+
+				uint64_t movement;
+				if (di == 0 && dj == 0) {
+					movement = (node.cell == agent.goal) ? 0 : (uint64_t)adj_movement;
+				}
+				else {
+					movement = (di != 0 && dj != 0) ? (uint64_t)diag_movement : (uint64_t)adj_movement;
+				}
+
+				uint64_t n_gcost = node.gcost + movement;
+				uint64_t n_key = ((uint64_t)(node.depth + 1) * n_cells) + n_cell;
+				std::unordered_map<uint64_t, uint64_t>::iterator it = best_gcost.find(n_key);
+				if (it != best_gcost.end() && it->second <= n_gcost) {
+					continue;
+				}
+				best_gcost[n_key] = n_gcost;
+
+				uint32_t n_h = goal_distance(goal_search, n_cell);
+				nodes.push_back(Node{ n_cell, node.depth + 1, n_gcost, node_index });
+				open_list.push(Queue_item(n_gcost + ((n_h == 0xFFFFFFFFu) ? unreachable_h : n_h), (int)(nodes.size() - 1)));
+			}
+		}
+	}
+
+	// Path to the end of the window, or the deepest conflict free part of it
+	agent.path.clear();
+	for (int n = deepest_node; n != -1; n = nodes[n].parent) {
+		agent.path.push_back(nodes[n].cell);
+	}
+	std::reverse(agent.path.begin(), agent.path.end());
+
+	// A part of the window is extended by waiting in its last cell for as long as that cell is free
+	while (agent.path.size() < window + 1) {
+		int holder = reservations.get_Holder(agent.path.back(), now + agent.path.size());
+		if (holder != -1 && holder != agent_index) {
+			break;
+		}
+		agent.path.push_back(agent.path.back());
+	}
+
+	// Not even the next step could be held (cannot happen while every agent holds its cell until the next replan tick), 
+	// reported not hidden
+	if (agent.path.size() < 2) {
+		failed_plans += 1;
+	}
+
+	// Swap the held cell for the reserved path (every cell of the path is free or already held by this agent)
+	for (uint64_t time = now + 1; time <= now + replan_interval; time++) {
+		reservations.release(agent.position, time, agent_index);
+	}
+	for (size_t d = 0; d < agent.path.size(); d++) {
+		reservations.reserve(agent.path[d], now + d, agent_index);
+	}
+}
+
+/* One time step */
+void Cooperative_planner::tick() {
+
+	uint64_t now = reservations.get_Now();
+
+	// All agents re-plan the next window together, on replan ticks or if any agent has run out of reserved path. 
+	// Every agent holds its own cell until the next replan tick before any of them plans, so agents planned earlier cannot 
+	// take it and an agent that finds no path through the window can wait in place until it re-plans. 
+	bool replan_tick = (now % replan_interval == 0);
+	for (size_t a = 0; a < agents.size() && replan_tick == false; a++) {
+		if (agents[a].path.size() <= 1) {
+			replan_tick = true;
+		}
+	}
+
+	if (replan_tick == true) {
+		std::chrono::steady_clock::time_point planning_start = std::chrono::steady_clock::now();
+		for (size_t a = 0; a < agents.size(); a++) {
+			release_agent((int)a);
+		}
+		for (size_t a = 0; a < agents.size(); a++) {
+			hold_position((int)a);
+		}
+		for (size_t a = 0; a < agents.size(); a++) {
+			plan_agent((int)a);
+			agents_planned += 1;
+		}
+		planning_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - planning_start).count();
+	}
+
+	// Move every agent one step along its reserved path
+	std::unordered_map<size_t, int> previous_cells;			// Cell -> agent at the start of the tick
+	for (size_t a = 0; a < agents.size(); a++) {
+		previous_cells[agents[a].position] = (int)a;
+		if (agents[a].path.size() > 1) {
+			agents[a].path.erase(agents[a].path.begin());
+			agents[a].position = agents[a].path[0];
+		}
+	}
+
+	// Count collisions (agents in one cell, or two agents which swapped cells), a check which stays 0
+	std::unordered_map<size_t, int> current_cells;
+	for (size_t a = 0; a < agents.size(); a++) {
+		if (current_cells.emplace(agents[a].position, (int)a).second == false) {
+			collisions += 1;
+		}
+	}
+	for (size_t a = 0; a < agents.size(); a++) {
+		std::unordered_map<size_t, int>::iterator it = previous_cells.find(agents[a].position);
+		if (it != previous_cells.end() && it->second > (int)a) {
+			Agent& other = agents[it->second];
+			std::unordered_map<size_t, int>::iterator back = previous_cells.find(other.position);
+			if (other.position != agents[a].position && back != previous_cells.end() && back->second == (int)a) {
+				collisions += 1;
+			}
+		}
+	}
+	reservations.advance();
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+/* Cooperative multi-agent planning (windowed hierarchical cooperative A*, WHCA*)
+- Agents are planned one after another in (cell, time) space against a shared reservation table, so later agents route 
+  around (or wait for) the cells earlier agents have reserved instead of colliding and being repaired afterwards. 
+- Only a window of time steps is planned and reserved. Every replan_interval ticks (less than the window, window >= 2) each 
+  agent re-plans the next window from where it is, so the cost per tick is bounded by the window and not by the length of 
+  the whole route. 
+- Beyond the window the search is guided by the true distance to the agent's goal ignoring other agents. The distances are 
+  computed lazily by a reverse resumable A* (RRA*) from the goal, which only expands cells until the queried cell is closed, 
+  and one search is shared by all agents with the same goal. 
+- Moves are the same 8-connected moves and costs as the single-agent search, plus waiting in place (adjacent cost, free at the goal). 
+- Vertex conflicts (two agents in one cell at one time) and swap conflicts (two agents exchanging cells) are avoided. 
+- Agents re-plan together: on replan ticks, and on any tick where an agent has run out of reserved path (e.g. it was just 
+  added). Before any of them plans, every agent releases its reservations and holds its own cell from now until the next 
+  replan tick (now + replan_interval). Agents planned earlier therefore cannot move into a cell whose agent may still have 
+  to wait there, and an agent whose search cannot reach the end of the window can always wait in place until it re-plans. 
+  It keeps the longest conflict free part of the window it found. 
+- Collisions are therefore avoided by construction. get_Failed_plans() (an agent which could not even hold its next step) 
+  and get_Collisions() (agents that end a tick in one cell or swap cells) are kept as checks and stay 0. */
+
+/* Include external modules */
+#include <cstdint>
+#include <iostream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+
+/* Space-time reservation table
+- Ring buffer of window + 1 time slots, each a hash map of reserved cell -> agent. Only times [now, now + window] are held, 
+  so memory is proportional to the number of reservations and not to cells x time. */
+class Reservation_table {
+
+private:
+	std::vector<std::unordered_map<size_t, int>>	slots;
+	uint64_t					now;
+
+	std::unordered_map<size_t, int>&	slot(uint64_t time)		{ return slots[time % slots.size()]; }
+	const std::unordered_map<size_t, int>&	slot(uint64_t time) const	{ return slots[time % slots.size()]; }
+
+public:
+	Reservation_table(size_t window) : slots(window + 1), now(0) {}
+
+	/* Agent holding a cell at a time, -1 if free (or outside of the window) */
+	int	get_Holder(size_t cell, uint64_t time) const;
+
+	/* Reserve/release a cell at a time (times outside of the window are ignored) */
+	void	reserve(size_t cell, uint64_t time, int agent);
+	void	release(size_t cell, uint64_t time, int agent);
+
+	/* Move to the next time step, the oldest slot is cleared and reused for now + window */
+	void	advance();
+
+	uint64_t	get_Now() const		{ return now; }
+	size_t		get_Window() const	{ return slots.size() - 1; }
+};
+
+class Cooperative_planner {
+
+private:
+	/* Reverse resumable A* from a goal (true distances to the goal ignoring other agents), shared by the agents with that goal */
+	struct Goal_search {
+		typedef std::tuple<uint64_t, uint32_t, size_t>	Queue_item;	// (fcost, gcost, cell)
+		struct Entry {
+			uint32_t	gcost	= 0xFFFFFFFFu;
+			bool		closed	= false;
+		};
+
+		size_t				goal, target;			// The heuristic points at the start of the first agent with this goal
+		std::unordered_map<size_t, Entry>	entries;			// Reached cells only
+		std::priority_queue<Queue_item, std::vector<Queue_item>, std::greater<Queue_item>>	open_list;
+	};
+
+	/* Agent state */
+	struct Agent {
+		size_t				position, goal;
+		std::vector<size_t>		path;				// Reserved cells for times now -> now + window (path[0] is the position)
+		std::shared_ptr<Goal_search>	goal_search;
+	};
+
+	size_t				rows, cols, n_cells;
+	int				diag_movement, adj_movement;
+	size_t				window, replan_interval;
+	std::vector<unsigned char>	passable;			// Obstacle flags read once from the grid
+	std::vector<Agent>		agents;
+	Reservation_table		reservations;
+	std::unordered_map<size_t, std::shared_ptr<Goal_search>>	goal_searches;		// By goal cell
+
+	// Counters
+	uint64_t			agents_planned, failed_plans, collisions;
+	double				planning_ms;
+
+	/* Octile distance between two cells (consistent for the 8-connected moves) */
+	uint64_t	octile_distance(size_t cell_a, size_t cell_b) const;
+
+	/* True distance from a cell to the goal of a search, resuming the search until the cell is closed (0xFFFFFFFF if unreachable) */
+	uint32_t	goal_distance(Goal_search& search, size_t cell);
+
+	/* Hold the agent's cell from now until the next replan tick (false if another agent holds it at one of these times) */
+	bool	hold_position(int agent_index);
+
+	/* Space-time A* for one agent over the window, result stored in the agent's path and reserved */
+	void	plan_agent(int agent_index);
+
+	/* Release the agent's reservations from now on */
+	void	release_agent(int agent_index);
+
+public:
+
+	/* Constructors and destructors */
+	Cooperative_planner(Cell_grid& grid, size_t row_PT, size_t col_PT, int diag_cost, int adj_cost, size_t window_size, size_t replan_ticks);
+
+	/* Add an agent at a start cell with a goal cell (contiguous indices), returns the agent index. The start cell must be 
+	passable and not taken by another agent. */
+	size_t	add_agent(size_t start_contig, size_t goal_contig);
+
+	/* One time step: re-plan every agent if it is a replan tick, then move every agent one step along its path */
+	void	tick();
+
+	/* Getters */
+	size_t		get_No_of_agents() const		{ return agents.size(); }
+	size_t		get_Agent_pos(size_t agent) const	{ return agents[agent].position; }
+	bool		get_Agent_at_goal(size_t agent) const	{ return agents[agent].position == agents[agent].goal; }
+	uint64_t	get_Time() const			{ return reservations.get_Now(); }
+	uint64_t	get_Agents_planned() const		{ return agents_planned; }
+	uint64_t	get_Failed_plans() const		{ return failed_plans; }
+	uint64_t	get_Collisions() const			{ return collisions; }
+	size_t		get_No_of_goal_searches() const		{ return goal_searches.size(); }
+	double		get_Planning_ms() const			{ return planning_ms; }
+};
@@ -0,0 +1,252 @@
+/* Implementation for the landmark (ALT) differential heuristic */
+
+#include "Landmark_heuristic.h"
+
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <utility>
+
+/* Distance from a landmark to a cell */
+uint32_t Landmark_heuristic::distance(size_t landmark, size_t cell) const {
+
+	if (wide == true) {
+		return dist32[(landmark * n_cells) + cell];
+	}
+	uint16_t dist = dist16[(landmark * n_cells) + cell];
+	return (dist == unreachable_16) ? unreachable_32 : (uint32_t)dist;
+}
+
+/* Hop count BFS (8-connected) from a cell */
+void Landmark_heuristic::bfs_hops(size_t source, std::vector<uint32_t>& hops) const {
+
+	hops.assign(n_cells, unreachable_32);
+	std::queue<size_t> frontier;
+	hops[source] = 0;
+	frontier.push(source);
+
+	while (frontier.empty() == false) {
+
+		size_t cell = frontier.front();
+		frontier.pop();
+
+		// Casting to int as the neighbour offsets can be negative 
+		int row = (int)(cell / cols);
+		int col = (int)(cell % cols);
+
+		for (int di = -1; di <= 1; di++) {
+			for (int dj = -1; dj <= 1; dj++) {
+				int n_row = row + di;
+				int n_col = col + dj;
+				if (n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+					continue;
+				}
+				size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+				if (passable[n_cell] == 1 && hops[n_cell] == unreachable_32) {
+					hops[n_cell] = hops[cell] + 1;
+					frontier.push(n_cell);
+				}
+			}
+		}
+	}
+}
+
+/* Dijkstra from a landmark with the movement costs */
+void Landmark_heuristic::dijkstra(size_t landmark, int diag_movement, int adj_movement) {
+
+	std::vector<uint32_t> dist(n_cells, unreachable_32);
+
+	typedef std::pair<uint32_t, size_t> Queue_item;
+	std::priority_queue<Queue_item, std::vector<Queue_item>, std::greater<Queue_item>> open_list;
+
+	size_t source = landmark_cells[landmark];
+	dist[source] = 0;
+	open_list.push(Queue_item(0, source));
+
+	while (open_list.empty() == false) {
+
+		Queue_item item = open_list.top();
+		open_list.pop();
+		size_t cell = item.second;
+		if (item.first > dist[cell]) {
+			continue;		// Stale queue entry
+		}
+
+		int row = (int)(cell / cols);
+		int col = (int)(cell % cols);
+
+		for (int di = -1; di <= 1; di++) {
+			for (int dj = -1; dj <= 1; dj++) {
+				int n_row = row + di;
+				int n_col = col + dj;
+				if ((di == 0 && dj == 0) || n_row < 0 || n_col < 0 || n_row >= (int)rows || n_col >= (int)cols) {
+					continue;
+				}
+				size_t n_cell = ((size_t)n_row * cols) + (size_t)n_col;
+				if (passable[n_cell] == 0) {
+					continue;
+				}
+				// Same movement costs as the A* neighbour loop
+				uint32_t movement = (di != 0 && dj != 0) ? (uint32_t)diag_movement : (uint32_t)adj_movement;
+				if (dist[cell] + movement < dist[n_cell]) {
+					dist[n_cell] = dist[cell] + movement;
+					open_list.push(Queue_item(dist[n_cell], n_cell));
+				}
+			}
+		}
+	}
+
+	// Store in the compact table (each thread writes its own landmark's slice)
+	size_t offset = landmark * n_cells;
+	for (size_t c = 0; c < n_cells; c++) {
+		if (wide == true) {
+			dist32[offset + c] = dist[c];
+		}
+		else {
+			dist16[offset + c] = (dist[c] == unreachable_32) ? unreachable_16 : (uint16_t)dist[c];
+		}
+	}
+}
+
+/* Pick landmarks and build their distance tables, is_obstacle(i, j) gives the obstacle flags (grid or snapshot) */
+template <typename Obstacle_fn>
+void Landmark_heuristic::preprocess_cells(const Obstacle_fn& is_obstacle, size_t row_PT, size_t col_PT, size_t no_of_landmarks, int diag_movement, int adj_movement, size_t n_threads) {
+
+	std::chrono::steady_clock::time_point preprocess_start = std::chrono::steady_clock::now();
+
+	rows	= row_PT;
+	cols	= col_PT;
+	n_cells	= rows * cols;
+	landmark_cells.clear();
+
+	// Read the obstacle flags once (single thread, the grid may be paged)
+	passable.assign(n_cells, 0);
+	size_t first_passable = n_cells;
+	for (size_t c = 0; c < n_cells; c++) {
+		if (is_obstacle(c / cols, c % cols) == false) {
+			passable[c] = 1;
+			if (first_passable == n_cells) {
+				first_passable = c;
+			}
+		}
+	}
+	if (first_passable == n_cells || no_of_landmarks == 0) {
+		preprocess_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - preprocess_start).count();
+		return;
+	}
+
+	/* Farthest-point selection on hop counts 
+	- First landmark is the cell farthest from an arbitrary passable cell, every next one is the cell farthest from all landmarks so far.
+	- Max hops from the landmarks bounds the distances (hops * largest movement) to choose the table width. */
+	std::vector<uint32_t> hops;
+	std::vector<uint32_t> min_hops(n_cells, unreachable_32);
+	uint32_t max_landmark_hops = 0;
+
+	bfs_hops(first_passable, hops);
+	size_t next_landmark = first_passable;
+	for (size_t c = 0; c < n_cells; c++) {
+		if (hops[c] != unreachable_32 && hops[c] > hops[next_landmark]) {
+			next_landmark = c;
+		}
+	}
+
+	for (size_t l = 0; l < no_of_landmarks; l++) {
+
+		landmark_cells.push_back(next_landmark);
+		bfs_hops(next_landmark, hops);
+
+		for (size_t c = 0; c < n_cells; c++) {
+			if (hops[c] == unreachable_32) {
+				continue;
+			}
+			if (hops[c] > max_landmark_hops) {
+				max_landmark_hops = hops[c];
+			}
+			if (hops[c] < min_hops[c]) {
+				min_hops[c] = hops[c];
+			}
+		}
+
+		size_t farthest = next_landmark;
+		for (size_t c = 0; c < n_cells; c++) {
+			if (min_hops[c] != unreachable_32 && min_hops[c] > min_hops[farthest]) {
+				farthest = c;
+			}
+		}
+
+		// Every reachable cell is already a landmark
+		if (min_hops[farthest] == 0) {
+			break;
+		}
+		next_landmark = farthest;
+	}
+
+	/* Distance tables, one Dijkstra per landmark in parallel */
+	uint32_t max_movement = (uint32_t)((diag_movement > adj_movement) ? diag_movement : adj_movement);
+	uint64_t distance_bound = (uint64_t)max_landmark_hops * max_movement;
+	wide = (distance_bound >= unreachable_16);
+
+	dist16.clear();
+	dist32.clear();
+	if (wide == true) {
+		dist32.assign(landmark_cells.size() * n_cells, unreachable_32);
+	}
+	else {
+		dist16.assign(landmark_cells.size() * n_cells, unreachable_16);
+	}
+
+	if (n_threads < 1) {
+		n_threads = 1;
+	}
+	std::vector<std::thread> workers;
+	for (size_t l_begin = 0; l_begin < landmark_cells.size(); l_begin += n_threads) {
+
+		workers.clear();
+		for (size_t l = l_begin; l < l_begin + n_threads && l < landmark_cells.size(); l++) {
+			workers.emplace_back(&Landmark_heuristic::dijkstra, this, l, diag_movement, adj_movement);
+		}
+		for (size_t t = 0; t < workers.size(); t++) {
+			workers[t].join();
+		}
+	}
+
+	passable.clear();
+	passable.shrink_to_fit();
+
+	preprocess_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - preprocess_start).count();
+}
+
+/* Pick landmarks and build their distance tables from the grid (map version 0) */
+void Landmark_heuristic::preprocess(Cell_grid& grid, size_t row_PT, size_t col_PT, size_t no_of_landmarks, int diag_movement, int adj_movement, size_t n_threads) {
+
+	preprocess_cells([&grid](size_t i, size_t j) { return grid(i, j).get_Obstacle(); }, row_PT, col_PT, no_of_landmarks, diag_movement, adj_movement, n_threads);
+	map_version = 0;
+}
+
+/* Pick landmarks and build their distance tables from a map snapshot (its version) */
+void Landmark_heuristic::preprocess(const Map_snapshot& map, size_t no_of_landmarks, int diag_movement, int adj_movement, size_t n_threads) {
+
+	preprocess_cells([&map](size_t i, size_t j) { return map.get_Obstacle(i, j); }, map.get_Rows(), map.get_Cols(), no_of_landmarks, diag_movement, adj_movement, n_threads);
+	map_version = map.get_Version();
+}
+
+/* Lower bound of the path cost from a cell to the end cell (max of the triangle inequality bounds) */
+int Landmark_heuristic::lower_bound(size_t contig, size_t end_contig) const {
+
+	uint32_t bound = 0;
+	for (size_t l = 0; l < landmark_cells.size(); l++) {
+
+		uint32_t dist_cell	= distance(l, contig);
+		uint32_t dist_end	= distance(l, end_contig);
+		if (dist_cell == unreachable_32 || dist_end == unreachable_32) {
+			continue;
+		}
+
+		uint32_t landmark_bound = (dist_cell > dist_end) ? dist_cell - dist_end : dist_end - dist_cell;
+		if (landmark_bound > bound) {
+			bound = landmark_bound;
+		}
+	}
+	return (int)bound;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/* Landmark (ALT) differential heuristic
+- K landmarks are picked by farthest-point selection (on hop counts, BFS), then one Dijkstra per landmark is run in parallel 
+  with the same movement costs as the search. Distances are stored per landmark as uint16 if they all fit, else uint32.
+- By the triangle inequality |d(L, end) - d(L, cell)| <= d(cell, end) for every landmark L, so the max over the landmarks is an 
+  admissible (and consistent) estimate. The search uses the max of it and the distance-only heuristic of Cell_ds. 
+- Much better informed than the distance-only heuristic on maze-like or room-based maps, where that one expands most of the grid. 
+- Tables are for the map at preprocessing time, preprocess again after the map changes. The tables record the Map_snapshot 
+  version they were built from (0 when built from the grid) and A_star_search does not use them with a snapshot of another 
+  version (after a shortcut is opened the bound would no longer be admissible). 
+- Tables are kept in RAM, 2 or 4 bytes per cell per landmark (plus a passable byte per cell), so they are not built for maps 
+  larger than RAM (GRID_LAYOUT 2, see main). */
+
+/* Include external modules */
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "Map_snapshot.h"
+
+class Landmark_heuristic {
+
+private:
+	static constexpr uint32_t	unreachable_32	= 0xFFFFFFFFu;
+	static constexpr uint16_t	unreachable_16	= 0xFFFFu;
+
+	size_t			rows, cols, n_cells;
+	std::vector<size_t>	landmark_cells;			// Contiguous index of each landmark
+	bool			wide;				// Distances stored as uint32 (dist32), else uint16 (dist16)
+	std::vector<uint16_t>	dist16;				// Landmark-major distance tables [landmark * n_cells + cell]
+	std::vector<uint32_t>	dist32;
+	double			preprocess_ms;
+	uint64_t		map_version;			// Snapshot version the tables were built from
+
+	/* Distance from a landmark to a cell, unreachable_32 if there is no path */
+	uint32_t	distance(size_t landmark, size_t cell) const;
+
+	/* Obstacle flags of the grid (row-major), read once so the worker threads do not touch the grid */
+	std::vector<unsigned char>	passable;
+
+	/* Hop count BFS (8-connected) from a cell, used for farthest-point selection */
+	void	bfs_hops(size_t source, std::vector<uint32_t>& hops) const;
+
+	/* Dijkstra from a landmark with the movement costs, written into the landmark's table */
+	void	dijkstra(size_t landmark, int diag_movement, int adj_movement);
+
+	/* Pick landmarks and build their tables, is_obstacle(i, j) gives the obstacle flags (grid or snapshot) */
+	template <typename Obstacle_fn>
+	void	preprocess_cells(const Obstacle_fn& is_obstacle, size_t row_PT, size_t col_PT, size_t no_of_landmarks, int diag_movement, int adj_movement, size_t n_threads);
+
+public:
+
+	/* Constructors and destructors */
+	Landmark_heuristic() : rows(0), cols(0), n_cells(0), wide(false), preprocess_ms(0.0), map_version(0) {}
+
+	/* Pick no_of_landmarks landmarks and build their distance tables using n_threads threads, from the grid (map version 0) 
+	or from a map snapshot (its version) */
+	void	preprocess(Cell_grid& grid, size_t row_PT, size_t col_PT, size_t no_of_landmarks, int diag_movement, int adj_movement, size_t n_threads);
+	void	preprocess(const Map_snapshot& map, size_t no_of_landmarks, int diag_movement, int adj_movement, size_t n_threads);
+
+	/* Lower bound of the path cost from a cell to the end cell (0 if no landmark reaches both) */
+	int	lower_bound(size_t contig, size_t end_contig) const;
+
+	/* Getters (preprocessing cost) */
+	size_t	get_No_of_landmarks() const		{ return landmark_cells.size(); }
+	double	get_Preprocess_ms() const		{ return preprocess_ms; }
+	uint64_t	get_Map_version() const		{ return map_version; }
+	size_t	get_Bytes_per_landmark() const		{ return n_cells * (wide == true ? sizeof(uint32_t) : sizeof(uint16_t)); }
+};
@@ -0,0 +1,194 @@
+/* Implementation for the copy-on-write map snapshots */
+
+#include "Map_snapshot.h"
+
+#include <unordered_map>
+
+/* Initial snapshot from the obstacle flags of the grid */
+Map_store::Map_store(Cell_grid& grid, size_t row_PT, size_t col_PT) : current(nullptr), global_epoch(1), path_cache(nullptr) {
+
+	for (size_t r = 0; r < max_readers; r++) {
+		readers[r].epoch.store(0);
+		readers[r].in_use.store(false);
+	}
+
+	Map_snapshot* snapshot = new Map_snapshot();
+	snapshot->version	= 0;
+	snapshot->rows		= row_PT;
+	snapshot->cols		= col_PT;
+	snapshot->tiles_per_row	= (col_PT + Map_snapshot::TILE - 1) / Map_snapshot::TILE;
+
+	size_t tile_rows = (row_PT + Map_snapshot::TILE - 1) / Map_snapshot::TILE;
+	snapshot->tiles.reserve(tile_rows * snapshot->tiles_per_row);
+
+	for (size_t tr = 0; tr < tile_rows; tr++) {
+		for (size_t tc = 0; tc < snapshot->tiles_per_row; tc++) {
+
+			std::shared_ptr<Map_snapshot::Tile> tile(new Map_snapshot::Tile());
+			for (size_t ti = 0; ti < Map_snapshot::TILE; ti++) {
+				for (size_t tj = 0; tj < Map_snapshot::TILE; tj++) {
+					size_t i = (tr * Map_snapshot::TILE) + ti;
+					size_t j = (tc * Map_snapshot::TILE) + tj;
+					bool obstacle = (i < row_PT && j < col_PT) ? grid(i, j).get_Obstacle() : true;	// Padding counts as obstacle
+					tile->obstacle[(ti * Map_snapshot::TILE) + tj] = obstacle ? 1 : 0;
+				}
+			}
+			snapshot->tiles.push_back(tile);
+		}
+	}
+
+	current.store(snapshot);
+}
+
+Map_store::~Map_store() {
+
+	// No readers may be active when the store is destroyed
+	std::lock_guard<std::mutex> guard(writer_lock);
+	for (size_t r = 0; r < retired.size(); r++) {
+		delete retired[r].first;
+	}
+	retired.clear();
+	delete current.load();
+}
+
+/* Claim a free reader slot, -1 if all are taken */
+int Map_store::register_reader() {
+
+	for (size_t r = 0; r < max_readers; r++) {
+		bool expected = false;
+		if (readers[r].in_use.compare_exchange_strong(expected, true) == true) {
+			return (int)r;
+		}
+	}
+	std::cout << "Error. No free map reader slots (max " << max_readers << ")\n";
+	return -1;
+}
+
+void Map_store::unregister_reader(int reader) {
+
+	// Nothing was registered for a failed register_reader() (-1)
+	if (reader < 0 || reader >= (int)max_readers) {
+		return;
+	}
+	readers[reader].epoch.store(0);
+	readers[reader].in_use.store(false);
+}
+
+/* Pin the global epoch and load the current snapshot
+- Epoch is published before the snapshot is loaded (both seq_cst), so a writer which replaced the snapshot before this load 
+  also sees this reader's epoch when deciding what to free. */
+Map_store::Read_guard::Read_guard(Map_store& map_store, int reader_slot) : store(map_store), reader(reader_slot), snapshot(nullptr) {
+
+	// Without a registered slot the epoch cannot be pinned and the snapshot could be freed while in use
+	if (reader < 0 || reader >= (int)max_readers || store.readers[reader].in_use.load() == false) {
+		std::cout << "Error. Map_store::Read_guard needs a slot from register_reader() (got " << reader << ")\n";
+		exit(-1);
+	}
+	store.readers[reader].epoch.store(store.global_epoch.load());
+	snapshot = store.current.load();
+}
+
+Map_store::Read_guard::~Read_guard() {
+	store.readers[reader].epoch.store(0);
+}
+
+/* Apply edits to a copy of the current snapshot and publish it */
+uint64_t Map_store::publish(const std::vector<Map_edit>& edits) {
+
+	std::lock_guard<std::mutex> guard(writer_lock);
+
+	const Map_snapshot* old_snapshot = current.load();
+
+	// Edits outside of the map would index past the tiles, the whole publish is rejected
+	for (size_t e = 0; e < edits.size(); e++) {
+		if (edits[e].row >= old_snapshot->rows || edits[e].col >= old_snapshot->cols) {
+			std::cout << "Error. Map edit (" << edits[e].row << ", " << edits[e].col << ") is outside of the " << old_snapshot->rows 
+				<< " x " << old_snapshot->cols << " map, nothing is published.\n";
+			return old_snapshot->version;
+		}
+	}
+
+	// Copy the tile list (tiles are shared, only the list is copied)
+	Map_snapshot* new_snapshot = new Map_snapshot(*old_snapshot);
+	new_snapshot->version = old_snapshot->version + 1;
+
+	// Clone a tile the first time it is edited, later edits to it go to the same clone
+	std::unordered_map<size_t, Map_snapshot::Tile*> cloned_tiles;
+
+	for (size_t e = 0; e < edits.size(); e++) {
+
+		size_t i = edits[e].row;
+		size_t j = edits[e].col;
+		size_t tile_index = ((i / Map_snapshot::TILE) * new_snapshot->tiles_per_row) + (j / Map_snapshot::TILE);
+
+		Map_snapshot::Tile* tile;
+		std::unordered_map<size_t, Map_snapshot::Tile*>::iterator it = cloned_tiles.find(tile_index);
+		if (it != cloned_tiles.end()) {
+			tile = it->second;
+		}
+		else {
+			std::shared_ptr<Map_snapshot::Tile> clone(new Map_snapshot::Tile(*new_snapshot->tiles[tile_index]));
+			tile = clone.get();
+			new_snapshot->tiles[tile_index] = clone;
+			cloned_tiles[tile_index] = tile;
+		}
+		tile->obstacle[((i % Map_snapshot::TILE) * Map_snapshot::TILE) + (j % Map_snapshot::TILE)] = edits[e].obstacle ? 1 : 0;
+	}
+
+	// Publish, then move the epoch on. Readers pinned at an older epoch may still hold the old snapshot
+	current.store(new_snapshot);
+	uint64_t retire_epoch = global_epoch.fetch_add(1) + 1;
+	retired.push_back(std::make_pair(old_snapshot, retire_epoch));
+
+	// Cached paths were found on an older snapshot
+	if (path_cache != nullptr) {
+		path_cache->invalidate(new_snapshot->version);
+	}
+
+	reclaim();
+
+	return new_snapshot->version;
+}
+
+/* Free retired snapshots no reader can still hold */
+void Map_store::reclaim() {
+
+	// Oldest epoch a reader is pinned at
+	uint64_t min_epoch = UINT64_MAX;
+	for (size_t r = 0; r < max_readers; r++) {
+		uint64_t epoch = readers[r].epoch.load();
+		if (epoch != 0 && epoch < min_epoch) {
+			min_epoch = epoch;
+		}
+	}
+
+	// Readers pinned at or after the retire epoch loaded the snapshot after it was replaced
+	size_t kept = 0;
+	for (size_t r = 0; r < retired.size(); r++) {
+		if (retired[r].second <= min_epoch) {
+			delete retired[r].first;
+		}
+		else {
+			retired[kept] = retired[r];
+			kept += 1;
+		}
+	}
+	retired.resize(kept);
+}
+
+/* Path cache versioned by the snapshots */
+void Map_store::set_Path_cache(Path_cache* cache) {
+
+	std::lock_guard<std::mutex> guard(writer_lock);
+	path_cache = cache;
+	if (path_cache != nullptr) {
+		path_cache->store_versions.store(true);
+		path_cache->map_version.store(current.load()->version);
+		path_cache->clear_shards();
+	}
+}
+
+size_t Map_store::get_No_of_retired() {
+	std::lock_guard<std::mutex> guard(writer_lock);
+	return retired.size();
+}
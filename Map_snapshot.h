@@ -0,0 +1,136 @@
+#pragma once
+
+/* Versioned, immutable map snapshots with tile-granular copy-on-write 
+- Once a Map_store exists its snapshots are the obstacle flags of the map. The grid keeps the obstacles it was built from 
+  (snapshot version 0) and its static cell data, and is not written by publish. Searches given a snapshot (in their 
+  Search_state) read obstacles only from it, so a writer can edit the map while searches run. A search reads one snapshot for 
+  its whole run. Cell changes after the store exists go through publish(), not the grid. 
+- A snapshot is a list of shared TILE x TILE tiles. Publishing edits copies the list and clones only the tiles which change, 
+  then swaps the current snapshot pointer atomically. 
+- Readers take no locks and never touch reference counts: they pin the global epoch, load the current snapshot and unpin when 
+  done. An old snapshot is freed (by the writer) once no reader is pinned at an epoch from before it was replaced. 
+- Component_labels and Landmark_heuristic record the version they were built from and are not updated by publish. Labels can 
+  follow the published edits with Component_labels::apply_edits. A Path_cache set with set_Path_cache() takes its map version 
+  from the snapshots (the current version when set, then every published version). 
+- A publish with an edit outside of the map is rejected (error printed, nothing is published, the current version returned). 
+- A snapshot keeps one obstacle byte per cell in RAM, so it is not built for maps larger than RAM (GRID_LAYOUT 2, see main). */
+
+/* Include external modules */
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "Path_cache.h"
+
+/* Single cell edit */
+struct Map_edit {
+	size_t	row, col;
+	bool	obstacle;
+};
+
+class Map_snapshot {
+
+public:
+	static constexpr size_t	TILE		= 32;
+	static constexpr size_t	tile_area	= TILE * TILE;
+
+	struct Tile {
+		unsigned char	obstacle[tile_area];
+	};
+
+private:
+	uint64_t					version;
+	size_t						rows, cols, tiles_per_row;
+	std::vector<std::shared_ptr<const Tile>>	tiles;
+
+	friend class Map_store;
+
+public:
+	Map_snapshot() : version(0), rows(0), cols(0), tiles_per_row(0) {}
+
+	/* Obstacle flag of a cell (no locking, the snapshot never changes) */
+	bool get_Obstacle(size_t i, size_t j) const {
+		const Tile& tile = *tiles[((i / TILE) * tiles_per_row) + (j / TILE)];
+		return tile.obstacle[((i % TILE) * TILE) + (j % TILE)] != 0;
+	}
+
+	uint64_t	get_Version() const	{ return version; }
+	size_t		get_Rows() const	{ return rows; }
+	size_t		get_Cols() const	{ return cols; }
+};
+
+class Map_store {
+
+public:
+	static constexpr size_t	max_readers	= 64;
+
+private:
+	/* Reader epoch slot (own cache line so readers do not share lines) */
+	struct alignas(64) Reader_slot {
+		std::atomic<uint64_t>	epoch;			// Pinned epoch, 0 if not reading
+		std::atomic<bool>	in_use;			// Slot registered to a reader thread
+	};
+
+	std::atomic<const Map_snapshot*>			current;
+	std::atomic<uint64_t>					global_epoch;
+	Reader_slot						readers[max_readers];
+
+	std::mutex						writer_lock;	// Writers are serialised, readers never take it
+	std::vector<std::pair<const Map_snapshot*, uint64_t>>	retired;	// Replaced snapshots and the epoch they were retired at
+	Path_cache*						path_cache;	// Moved to each published version (nullptr if none)
+
+	/* Free retired snapshots no reader can still hold (writer lock must be held) */
+	void	reclaim();
+
+public:
+
+	/* Constructors and destructors */
+	// Initial snapshot (version 0) from the obstacle flags of the grid
+	Map_store(Cell_grid& grid, size_t row_PT, size_t col_PT);
+	~Map_store();
+
+	Map_store(const Map_store&) = delete;
+	Map_store& operator=(const Map_store&) = delete;
+
+	/* Reader slots, one per reader thread. register_reader() returns -1 if all max_readers slots are taken, which the 
+	caller must check (a Read_guard on an unregistered slot is an error) */
+	int	register_reader();
+	void	unregister_reader(int reader);
+
+	/* Pin a snapshot for the lifetime of the guard (e.g. one search) */
+	class Read_guard {
+	private:
+		Map_store&		store;
+		int			reader;
+		const Map_snapshot*	snapshot;
+	public:
+		Read_guard(Map_store& map_store, int reader_slot);
+		~Read_guard();
+		Read_guard(const Read_guard&) = delete;
+		Read_guard& operator=(const Read_guard&) = delete;
+
+		const Map_snapshot*	get() const		{ return snapshot; }
+	};
+
+	/* Apply edits to a copy of the current snapshot and publish it atomically, returns the new version. If an edit is outside 
+	of the map nothing is published and the current version is returned */
+	uint64_t	publish(const std::vector<Map_edit>& edits);
+
+	/* Path cache versioned by the snapshots, moved to the current version now and invalidated (moved to the new version) on 
+	every publish */
+	void		set_Path_cache(Path_cache* cache);
+
+	/* Number of replaced snapshots not yet freed */
+	size_t		get_No_of_retired();
+};
@@ -0,0 +1,330 @@
+/* Implementation for the paged (out-of-core) grid */
+
+#include "A_star_functions.h"
+#include "Paged_grid.h"
+
+#include <cstdio>
+#include <new>
+
+/* Cell flags written to the spill file, one byte per cell */
+static const char flag_obstacle	= 1;
+static const char flag_start	= 2;
+static const char flag_end	= 4;
+
+Paged_grid::Paged_grid(size_t col_size) :
+	rows(0), cols(col_size), tiles_per_row(0), tile_rows(0), spacing(1.0f),
+	slot_data(nullptr), last_tile(0), last_slot(0),
+	readahead_pending(false), readahead_tile(0), have_last_miss(false), last_miss_tile(0) {}
+
+Paged_grid::~Paged_grid() {
+
+	if (readahead_pending == true) {
+		readahead_data.wait();
+	}
+	::operator delete(slot_data);
+	spill_file.close();
+	if (spill_path.empty() == false) {
+		std::remove(spill_path.c_str());
+	}
+}
+
+/* Set the map and spill files and the number of tiles kept in memory */
+void Paged_grid::open(const std::string& map_file, const std::string& spill_file_path, size_t max_cached_tiles) {
+
+	map_path	= map_file;
+	spill_path	= spill_file_path;
+
+	if (max_cached_tiles < min_cached_tiles) {
+		max_cached_tiles = min_cached_tiles;
+	}
+	::operator delete(slot_data);
+	slot_data = static_cast<Cell_ds*>(::operator new(max_cached_tiles * tile_area * sizeof(Cell_ds)));
+	slots.assign(max_cached_tiles, Tile_slot{ 0, false, lru.end(), std::vector<char>(tile_area, 0) });
+	tile_to_slot.clear();
+	lru.clear();
+
+	// Spill file is scratch space for this grid only (truncated)
+	spill_file.open(spill_path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	if (spill_file.is_open() == false) {
+		std::cout << "Error. Could not open tile spill file " << spill_path << "\n";
+		exit(-1);
+	}
+}
+
+/* Set the size of the map, no cells are constructed */
+void Paged_grid::reserve(size_t row_size, size_t col_size) {
+
+	if (slot_data == nullptr) {
+		std::cout << "Error. Paged_grid::open must be called before reserve.\n";
+		exit(-1);
+	}
+	rows		= row_size;
+	cols		= col_size;
+	tiles_per_row	= (cols + TILE - 1) / TILE;
+	tile_rows	= (rows + TILE - 1) / TILE;
+	spilled.assign(tiles_per_row * tile_rows, false);
+}
+
+/* Element access, loads the tile if it is not cached */
+Cell_ds& Paged_grid::operator()(size_t i, size_t j) {
+
+	size_t tile = tile_of(i, j);
+	size_t slot = slot_for_tile(tile);
+	return slot_cells(slot)[((i % TILE) * TILE) + (j % TILE)];
+}
+
+/* Slot holding a tile (loads it on a miss) and mark it most recently used */
+size_t Paged_grid::slot_for_tile(size_t tile) {
+
+	// Fast path, the frontier mostly stays in one tile
+	if (lru.empty() == false && tile == last_tile && slots[last_slot].in_use == true && slots[last_slot].tile == tile) {
+		metrics.tile_hits += 1;
+		return last_slot;
+	}
+
+	size_t slot;
+	std::unordered_map<size_t, size_t>::iterator it = tile_to_slot.find(tile);
+	if (it != tile_to_slot.end()) {
+		metrics.tile_hits += 1;
+		slot = it->second;
+		lru.splice(lru.begin(), lru, slots[slot].lru_pos);
+	}
+	else {
+		metrics.tile_misses += 1;
+		slot = load_tile(tile);
+	}
+
+	last_tile = tile;
+	last_slot = slot;
+	return slot;
+}
+
+/* Load a tile into a free (or the least recently used) slot */
+size_t Paged_grid::load_tile(size_t tile) {
+
+	// Pick a slot, evict the least recently used tile if the cache is full
+	size_t slot;
+	if (lru.size() < slots.size()) {
+		slot = lru.size();
+	}
+	else {
+		slot = lru.back();
+		evict_slot(slot);
+	}
+
+	std::chrono::steady_clock::time_point stall_start = std::chrono::steady_clock::now();
+
+	// Use the read-ahead data if it is for this tile, else read synchronously
+	std::vector<char> bytes;
+	if (readahead_pending == true && readahead_tile == tile) {
+		bytes = readahead_data.get();
+		readahead_pending = false;
+		metrics.readahead_hits += 1;
+	}
+	else if (spilled[tile] == true) {
+		bytes = read_tile_bytes(spill_path, (uint64_t)tile * tile_area, tile_area);
+	}
+	else if (map_path.empty() == false) {
+		bytes = read_tile_bytes(map_path, (uint64_t)tile * tile_area, tile_area);
+	}
+
+	metrics.io_stall_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stall_start).count();
+
+	// A pending read-ahead for this tile was issued while it was not cached either, so it read the same file
+	construct_tile(tile, slot, bytes, spilled[tile]);
+
+	slots[slot].tile		= tile;
+	read_flags(slot, slots[slot].load_flags);
+	slots[slot].in_use	= true;
+	lru.push_front(slot);
+	slots[slot].lru_pos	= lru.begin();
+	tile_to_slot[tile]	= slot;
+
+	// Read ahead the next tile in the direction the misses are moving (frontier direction)
+	if (have_last_miss == true) {
+		int tr = (int)(tile / tiles_per_row);
+		int tc = (int)(tile % tiles_per_row);
+		int dr = tr - (int)(last_miss_tile / tiles_per_row);
+		int dc = tc - (int)(last_miss_tile % tiles_per_row);
+		dr = (dr > 0) - (dr < 0);
+		dc = (dc > 0) - (dc < 0);
+
+		int next_tr = tr + dr;
+		int next_tc = tc + dc;
+		if ((dr != 0 || dc != 0) && next_tr >= 0 && next_tc >= 0 && next_tr < (int)tile_rows && next_tc < (int)tiles_per_row) {
+			issue_readahead(((size_t)next_tr * tiles_per_row) + (size_t)next_tc);
+		}
+	}
+	have_last_miss = true;
+	last_miss_tile = tile;
+
+	return slot;
+}
+
+/* Start an asynchronous read of a tile which is not cached */
+void Paged_grid::issue_readahead(size_t tile) {
+
+	if (tile_to_slot.find(tile) != tile_to_slot.end()) {
+		return;
+	}
+
+	// Only one read in flight, drop a finished one which was not used, leave an unfinished one alone
+	if (readahead_pending == true) {
+		if (readahead_tile == tile || readahead_data.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			return;
+		}
+		readahead_data.get();
+		readahead_pending = false;
+	}
+
+	if (spilled[tile] == true) {
+		readahead_data = std::async(std::launch::async, &Paged_grid::read_tile_bytes, spill_path, (uint64_t)tile * tile_area, tile_area);
+	}
+	else if (map_path.empty() == false) {
+		readahead_data = std::async(std::launch::async, &Paged_grid::read_tile_bytes, map_path, (uint64_t)tile * tile_area, tile_area);
+	}
+	else {
+		return;		// Nothing to read, tile is constructed as all passable
+	}
+	readahead_pending = true;
+	readahead_tile = tile;
+}
+
+/* Write the flags of a cached tile to the spill file if they changed and free its slot */
+void Paged_grid::evict_slot(size_t slot) {
+
+	size_t tile = slots[slot].tile;
+
+	// operator() hands out writable references, so changes are detected by comparing the flags with the ones taken at load. 
+	// An unchanged tile is the same as its map data (or its spill data if it was spilled before) and is dropped without writing
+	std::vector<char> flags;
+	read_flags(slot, flags);
+	if (flags == slots[slot].load_flags) {
+		metrics.clean_evictions += 1;
+	}
+	else {
+		std::chrono::steady_clock::time_point stall_start = std::chrono::steady_clock::now();
+
+		spill_file.seekp((std::streamoff)((uint64_t)tile * tile_area));
+		spill_file.write(flags.data(), (std::streamsize)tile_area);
+		spill_file.flush();		// Read-ahead reads the spill file through its own stream
+		spilled[tile] = true;
+		metrics.tiles_spilled += 1;
+
+		metrics.io_stall_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stall_start).count();
+	}
+
+	lru.erase(slots[slot].lru_pos);
+	tile_to_slot.erase(tile);
+	slots[slot].in_use = false;
+}
+
+/* Flags of the cells of a cached tile (padding of edge tiles is 0) */
+void Paged_grid::read_flags(size_t slot, std::vector<char>& flags) {
+
+	Cell_ds* cells = slot_cells(slot);
+	size_t row_begin = (slots[slot].tile / tiles_per_row) * TILE;
+	size_t col_begin = (slots[slot].tile % tiles_per_row) * TILE;
+
+	flags.assign(tile_area, 0);
+	for (size_t ti = 0; ti < TILE; ti++) {
+		for (size_t tj = 0; tj < TILE; tj++) {
+
+			if (row_begin + ti >= rows || col_begin + tj >= cols) {
+				continue;		// Padding of edge tiles
+			}
+			Cell_ds& cell = cells[(ti * TILE) + tj];
+			char cell_flags = 0;
+			cell_flags |= (cell.get_Obstacle() == true) ? flag_obstacle : 0;
+			cell_flags |= (cell.get_isStart() == true) ? flag_start : 0;
+			cell_flags |= (cell.get_isEnd() == true) ? flag_end : 0;
+			flags[(ti * TILE) + tj] = cell_flags;
+		}
+	}
+}
+
+/* Construct the cells of a tile from spilled cell flags, map obstacle bytes or as all passable */
+void Paged_grid::construct_tile(size_t tile, size_t slot, const std::vector<char>& bytes, bool from_spill) {
+
+	Cell_ds* cells = slot_cells(slot);
+
+	size_t row_begin = (tile / tiles_per_row) * TILE;
+	size_t col_begin = (tile % tiles_per_row) * TILE;
+
+	for (size_t ti = 0; ti < TILE; ti++) {
+		for (size_t tj = 0; tj < TILE; tj++) {
+
+			size_t i = row_begin + ti;
+			size_t j = col_begin + tj;
+			if (i >= rows || j >= cols) {
+				continue;		// Padding of edge tiles
+			}
+
+			Cell_ds* cell = new (&cells[(ti * TILE) + tj]) Cell_ds((int)((i * cols) + j), i, j, cols, j * spacing, i * spacing);
+
+			int boundary_val = boundary_pt_value(i, j, rows, cols);
+			if (boundary_val != 0) {
+				cell->set_Boundary_pt();
+				cell->set_Boundary_pt_val(boundary_val);
+			}
+			if (bytes.empty() == true) {
+				continue;
+			}
+
+			char cell_bytes = bytes[(ti * TILE) + tj];
+			if (from_spill == false) {
+				cell_bytes = (cell_bytes != 0) ? flag_obstacle : 0;		// Map file, any non zero byte is an obstacle
+			}
+			if ((cell_bytes & flag_obstacle) != 0) {
+				cell->set_Obstacle();
+			}
+			if ((cell_bytes & flag_start) != 0) {
+				cell->set_Start();
+			}
+			if ((cell_bytes & flag_end) != 0) {
+				cell->set_End();
+			}
+		}
+	}
+}
+
+/* Read the bytes of a tile */
+std::vector<char> Paged_grid::read_tile_bytes(const std::string& path, uint64_t offset, size_t bytes) {
+
+	std::vector<char> data(bytes, 0);
+	std::ifstream file(path, std::ios::in | std::ios::binary);
+	if (file.is_open() == false) {
+		std::cout << "Error. Could not open tile file " << path << "\n";
+		exit(-1);
+	}
+	file.seekg((std::streamoff)offset);
+	file.read(data.data(), (std::streamsize)bytes);
+	return data;
+}
+
+/* Write a map file from row-major obstacle bytes */
+void Paged_grid::write_map_file(const std::string& path, size_t row_size, size_t col_size, const std::vector<unsigned char>& obstacles) {
+
+	size_t n_tiles_per_row	= (col_size + TILE - 1) / TILE;
+	size_t n_tile_rows	= (row_size + TILE - 1) / TILE;
+
+	std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	std::vector<char> tile_bytes(tile_area, 0);
+
+	for (size_t tr = 0; tr < n_tile_rows; tr++) {
+		for (size_t tc = 0; tc < n_tiles_per_row; tc++) {
+
+			std::fill(tile_bytes.begin(), tile_bytes.end(), 0);
+			for (size_t ti = 0; ti < TILE; ti++) {
+				for (size_t tj = 0; tj < TILE; tj++) {
+					size_t i = (tr * TILE) + ti;
+					size_t j = (tc * TILE) + tj;
+					if (i < row_size && j < col_size) {
+						tile_bytes[(ti * TILE) + tj] = (char)obstacles[(i * col_size) + j];
+					}
+				}
+			}
+			file.write(tile_bytes.data(), (std::streamsize)tile_area);
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+/* Paged (out-of-core) grid for maps larger than RAM (drop in for RMF::DYN_C2D in the grid functions)
+- The map is split into TILE x TILE tiles which are loaded from disk on demand into an LRU tile cache of fixed size. 
+- Map file: one obstacle byte (0 or 1) per cell stored tile by tile (write_map_file), no map file means every cell is passable. 
+- Cells are constructed when their tile is loaded (position, boundary value and obstacle), nothing is materialised up front.
+- Evicted tiles are written to a spill file as one flags byte per cell (obstacle, start and end point), the only cell data 
+  which is changed on the grid. Per-search state (costs, parents, open/closed flags) is kept in Search_state and never written 
+  to the grid. Position, ID and boundary value are rebuilt when the tile is loaded again, any other change to a cell is lost 
+  at eviction. Only tiles whose flags changed since they were loaded are written (compared with the flags taken at load), 
+  clean tiles are dropped and loaded again from the map (or their earlier spill). The spill file holds a tile at its tile 
+  offset, so it is at most the size of the map file (1 byte per cell), unwritten tiles are holes (sparse on most file systems). 
+- On a miss, the next tile along the direction the misses are moving in (the search frontier) is read ahead asynchronously. 
+- References returned by grid(i, j) are only valid until a tile is evicted. Tiles are evicted least recently used first and at least 
+  min_cached_tiles are kept, so a couple of references used together in one expression are safe. Do not hold them across a search step. 
+- Not thread safe (the tile cache is updated on every access), use from one thread only. */
+
+/* Include external modules */
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <future>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+
+/* Tile cache metrics */
+struct Paged_grid_metrics {
+	uint64_t	tile_hits		= 0;		// Accesses to a tile already in the cache
+	uint64_t	tile_misses		= 0;		// Accesses which had to load a tile
+	uint64_t	readahead_hits		= 0;		// Misses served by the asynchronous read-ahead
+	uint64_t	tiles_spilled		= 0;		// Evicted tiles written to the spill file
+	uint64_t	clean_evictions		= 0;		// Evicted tiles dropped without writing (unchanged since loaded)
+	double		io_stall_ms		= 0.0;		// Time spent blocked on tile reads/writes
+};
+
+class Paged_grid {
+
+public:
+	static constexpr size_t	TILE			= 64;
+	static constexpr size_t	tile_area		= TILE * TILE;
+	static constexpr size_t	min_cached_tiles	= 4;
+
+private:
+	/* Cached tile */
+	struct Tile_slot {
+		size_t				tile;			// Tile index held in the slot
+		bool				in_use;
+		std::list<size_t>::iterator	lru_pos;		// Position in the LRU list
+		std::vector<char>		load_flags;		// Cell flags when loaded (dirty check at eviction)
+	};
+
+	size_t					rows, cols;
+	size_t					tiles_per_row, tile_rows;
+	float					spacing;
+
+	std::string				map_path, spill_path;
+	std::fstream				spill_file;
+	std::vector<bool>			spilled;		// Tile has up to date cell flags in the spill file
+
+	Cell_ds*				slot_data;		// Raw storage for the cached tiles (max_tiles * tile_area cells)
+	std::vector<Tile_slot>			slots;
+	std::unordered_map<size_t, size_t>	tile_to_slot;
+	std::list<size_t>			lru;			// Slot indices, most recently used first
+
+	size_t					last_tile, last_slot;	// Fast path for repeated accesses to the same tile
+
+	// Read-ahead (one tile in flight)
+	bool					readahead_pending;
+	size_t					readahead_tile;
+	std::future<std::vector<char>>		readahead_data;
+	bool					have_last_miss;
+	size_t					last_miss_tile;
+
+	Paged_grid_metrics			metrics;
+
+	/* Tile helpers */
+	size_t	tile_of(size_t i, size_t j) const	{ return ((i / TILE) * tiles_per_row) + (j / TILE); }
+	Cell_ds*	slot_cells(size_t slot)		{ return slot_data + (slot * tile_area); }
+	size_t	slot_for_tile(size_t tile);
+	size_t	load_tile(size_t tile);
+	void	evict_slot(size_t slot);
+	void	construct_tile(size_t tile, size_t slot, const std::vector<char>& bytes, bool from_spill);
+	void	read_flags(size_t slot, std::vector<char>& flags);
+	void	issue_readahead(size_t tile);
+
+	/* Read the bytes of a tile (spilled cell flags if spilled, else the map obstacle bytes), used by the read-ahead thread too */
+	static std::vector<char> read_tile_bytes(const std::string& path, uint64_t offset, size_t bytes);
+
+public:
+
+	/* Constructors and destructors */
+	// Collumns known (rows defined when reserving, same as DYN_C2D)
+	Paged_grid(size_t col_size);
+	~Paged_grid();
+
+	Paged_grid(const Paged_grid&) = delete;
+	Paged_grid& operator=(const Paged_grid&) = delete;
+
+	/* Set the map and spill files and the number of tiles kept in memory (call before reserve) */
+	void	open(const std::string& map_file, const std::string& spill_file_path, size_t max_cached_tiles);
+
+	/* Set the size of the map, no cells are constructed */
+	void	reserve(size_t row_size, size_t col_size);
+	void	set_Spacing(float cell_spacing)		{ spacing = cell_spacing; }
+
+	/* Element access with row and collumn index or row-major contiguous index (cell ID) */
+	Cell_ds&	operator()(size_t i, size_t j);
+	Cell_ds&	operator()(size_t contig)		{ return (*this)(contig / cols, contig % cols); }
+
+	size_t		get_Rows() const			{ return rows; }
+	size_t		get_Cols() const			{ return cols; }
+	const Paged_grid_metrics&	get_Metrics() const	{ return metrics; }
+
+	/* Write a map file from row-major obstacle bytes (0 passable, 1 obstacle) */
+	static void	write_map_file(const std::string& path, size_t row_size, size_t col_size, const std::vector<unsigned char>& obstacles);
+};
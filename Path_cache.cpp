@@ -0,0 +1,164 @@
+/* Implementation for the path query cache */
+
+#include "Path_cache.h"
+
+#include <algorithm>
+
+Path_cache::Path_cache(size_t no_of_shards, size_t capacity) :
+	shard_capacity(0), map_version(0), store_versions(false), hits(0), subpath_hits(0), misses(0), evictions(0) {
+
+	if (no_of_shards < 1) {
+		no_of_shards = 1;
+	}
+	shard_capacity = (capacity + no_of_shards - 1) / no_of_shards;
+	if (shard_capacity < 1) {
+		shard_capacity = 1;
+	}
+
+	shards.reserve(no_of_shards);
+	for (size_t s = 0; s < no_of_shards; s++) {
+		shards.push_back(std::unique_ptr<Shard>(new Shard()));
+	}
+}
+
+/* Remove an entry and its path cells from the shard (shard lock must be held) */
+void Path_cache::erase_entry(Shard& shard, Entry_it entry) {
+
+	for (size_t p = 0; p < entry->path_cell_IDs.size(); p++) {
+		auto range = shard.cell_index.equal_range(entry->path_cell_IDs[p]);
+		for (auto it = range.first; it != range.second; ++it) {
+			if (it->second.first == entry) {
+				shard.cell_index.erase(it);
+				break;
+			}
+		}
+	}
+	shard.index.erase(entry->query);
+	shard.lru.erase(entry);
+}
+
+/* Look for a cached path in the shard with both the start and end cells on it (shard lock must be held) */
+bool Path_cache::lookup_subpath(Shard& shard, const Path_query& query, std::vector<int>& path_cell_IDs) {
+
+	auto start_range = shard.cell_index.equal_range(query.start_ID);
+	for (auto s_it = start_range.first; s_it != start_range.second; ++s_it) {
+
+		Entry_it entry = s_it->second.first;
+		if (entry->query.same_map_and_options(query) == false) {
+			continue;
+		}
+
+		auto end_range = shard.cell_index.equal_range(query.end_ID);
+		for (auto e_it = end_range.first; e_it != end_range.second; ++e_it) {
+
+			if (e_it->second.first != entry) {
+				continue;
+			}
+			size_t start_pos = s_it->second.second;
+			size_t end_pos = e_it->second.second;
+
+			// Slice the cached path, reversed if the query goes the other way along it 
+			if (start_pos <= end_pos) {
+				path_cell_IDs.assign(entry->path_cell_IDs.begin() + start_pos, entry->path_cell_IDs.begin() + end_pos + 1);
+			}
+			else {
+				path_cell_IDs.assign(entry->path_cell_IDs.begin() + end_pos, entry->path_cell_IDs.begin() + start_pos + 1);
+				std::reverse(path_cell_IDs.begin(), path_cell_IDs.end());
+			}
+			shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Look up a path (exact query first, then sub-paths of cached paths) */
+bool Path_cache::lookup(const Path_query& query, std::vector<int>& path_cell_IDs) {
+
+	// Exact query
+	{
+		Shard& shard = shard_for(query);
+		std::lock_guard<std::mutex> guard(shard.lock);
+
+		auto it = shard.index.find(query);
+		if (it != shard.index.end()) {
+			path_cell_IDs = it->second->path_cell_IDs;
+			shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+			hits += 1;
+			return true;
+		}
+	}
+
+	// Sub-path of any cached path (one shard locked at a time)
+	for (size_t s = 0; s < shards.size(); s++) {
+		std::lock_guard<std::mutex> guard(shards[s]->lock);
+		if (lookup_subpath(*shards[s], query, path_cell_IDs) == true) {
+			subpath_hits += 1;
+			return true;
+		}
+	}
+
+	misses += 1;
+	return false;
+}
+
+/* Store a found path */
+void Path_cache::insert(const Path_query& query, const std::vector<int>& path_cell_IDs) {
+
+	Shard& shard = shard_for(query);
+	std::lock_guard<std::mutex> guard(shard.lock);
+
+	// Map changed since the query was made (checked under the lock so invalidate() cannot miss it)
+	if (query.map_version != map_version.load()) {
+		return;
+	}
+
+	// Replace an existing entry for the same query
+	auto it = shard.index.find(query);
+	if (it != shard.index.end()) {
+		erase_entry(shard, it->second);
+	}
+
+	// Evict least recently used entries if the shard is full
+	while (shard.lru.size() >= shard_capacity) {
+		erase_entry(shard, std::prev(shard.lru.end()));
+		evictions += 1;
+	}
+
+	shard.lru.push_front(Entry{ query, path_cell_IDs });
+	Entry_it entry = shard.lru.begin();
+	shard.index[query] = entry;
+	for (size_t p = 0; p < path_cell_IDs.size(); p++) {
+		shard.cell_index.insert(std::make_pair(path_cell_IDs[p], std::make_pair(entry, p)));
+	}
+}
+
+/* Drop every cached path (the map version must already have been moved on) */
+void Path_cache::clear_shards() {
+
+	for (size_t s = 0; s < shards.size(); s++) {
+		std::lock_guard<std::mutex> guard(shards[s]->lock);
+		shards[s]->cell_index.clear();
+		shards[s]->index.clear();
+		shards[s]->lru.clear();
+	}
+}
+
+/* Map has changed, bump the map version and drop every cached path */
+void Path_cache::invalidate() {
+
+	// Versions of a Map_store cache only come from its snapshots (queries are keyed on them)
+	if (store_versions.load() == false) {
+		map_version += 1;
+	}
+	clear_shards();
+}
+
+/* Map has changed to a known version (e.g. a published snapshot), move to it and drop every cached path */
+void Path_cache::invalidate(uint64_t new_map_version) {
+
+	// Versions only move forward (publishers may race)
+	uint64_t version = map_version.load();
+	while (version < new_map_version && map_version.compare_exchange_weak(version, new_map_version) == false) {}
+	clear_shards();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+/* Cache of computed paths keyed by (map version, start cell, end cell, movement costs)
+- Sharded LRU: each shard has its own lock and LRU list so concurrent lookups from worker threads mostly hit different locks. 
+- The map version has one source. Without a Map_store any change to the map must call invalidate(), which bumps the cache's 
+  own map version and drops every cached path (Component_labels grid toggles do this for a cache set with set_Path_cache()). 
+  A cache set with Map_store::set_Path_cache() takes the versions of the published snapshots instead: it is moved to the 
+  current snapshot version then, and to every newly published version. invalidate() then only drops the cached paths, so 
+  queries keyed on the snapshot version are still stored. 
+- Sub-path reuse: a sub-path of an optimal path is optimal, so a query whose start and end cells both lie on a cached path 
+  (same map version and movement costs) is answered with that part of the cached path (reversed if needed, moves are symmetric). */
+
+/* Include external modules */
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Map_store;
+
+/* Path query key */
+struct Path_query {
+	uint64_t	map_version;
+	int		start_ID, end_ID;				// Cell IDs (contiguous index) of the start and end points
+	int		diag_movement, adj_movement;			// Search options (movement costs)
+
+	bool operator==(const Path_query& other) const {
+		return map_version == other.map_version && start_ID == other.start_ID && end_ID == other.end_ID 
+			&& diag_movement == other.diag_movement && adj_movement == other.adj_movement;
+	}
+
+	// Same map and options (sub-path reuse only needs these to match)
+	bool same_map_and_options(const Path_query& other) const {
+		return map_version == other.map_version && diag_movement == other.diag_movement && adj_movement == other.adj_movement;
+	}
+};
+
+struct Path_query_hash {
+	size_t operator()(const Path_query& query) const {
+		uint64_t hash = query.map_version;
+		hash = (hash * 0x9E3779B97F4A7C15ull) ^ (uint64_t)(uint32_t)query.start_ID;
+		hash = (hash * 0x9E3779B97F4A7C15ull) ^ (uint64_t)(uint32_t)query.end_ID;
+		hash = (hash * 0x9E3779B97F4A7C15ull) ^ (uint64_t)(uint32_t)query.diag_movement;
+		hash = (hash * 0x9E3779B97F4A7C15ull) ^ (uint64_t)(uint32_t)query.adj_movement;
+		return (size_t)(hash ^ (hash >> 29));
+	}
+};
+
+class Path_cache {
+
+private:
+	/* Cached path, stored start -> end as cell IDs */
+	struct Entry {
+		Path_query		query;
+		std::vector<int>	path_cell_IDs;
+	};
+	typedef std::list<Entry>::iterator	Entry_it;
+
+	struct Shard {
+		std::mutex						lock;
+		std::list<Entry>					lru;		// Most recently used first
+		std::unordered_map<Path_query, Entry_it, Path_query_hash>	index;
+		std::unordered_multimap<int, std::pair<Entry_it, size_t>>	cell_index;	// Path cell ID -> (entry, position on the path)
+	};
+
+	size_t					shard_capacity;			// Max entries per shard 
+	std::vector<std::unique_ptr<Shard>>	shards;
+	std::atomic<uint64_t>			map_version;
+	std::atomic<bool>			store_versions;			// Map version set by a Map_store (its snapshot versions)
+
+	// Counters
+	std::atomic<uint64_t>			hits, subpath_hits, misses, evictions;
+
+	Shard&	shard_for(const Path_query& query)	{ return *shards[Path_query_hash()(query) % shards.size()]; }
+	void	erase_entry(Shard& shard, Entry_it entry);
+	void	clear_shards();
+	bool	lookup_subpath(Shard& shard, const Path_query& query, std::vector<int>& path_cell_IDs);
+
+	friend class Map_store;
+
+public:
+
+	/* Constructors and destructors */
+	Path_cache(size_t no_of_shards, size_t capacity);
+
+	Path_cache(const Path_cache&) = delete;
+	Path_cache& operator=(const Path_cache&) = delete;
+
+	/* Look up a path (exact query first, then sub-paths of cached paths), returns false on a miss */
+	bool		lookup(const Path_query& query, std::vector<int>& path_cell_IDs);
+
+	/* Store a found path (start -> end cell IDs). Paths for an old map version are not stored */
+	void		insert(const Path_query& query, const std::vector<int>& path_cell_IDs);
+
+	/* Map has changed, bump the map version (or move it to new_map_version if that is newer) and drop every cached path. 
+	A cache versioned by a Map_store keeps its version on invalidate() and only drops the paths */
+	void		invalidate();
+	void		invalidate(uint64_t new_map_version);
+
+	/* Getters */
+	uint64_t	get_Map_version() const		{ return map_version.load(); }
+	uint64_t	get_Hits() const		{ return hits.load(); }
+	uint64_t	get_Subpath_hits() const	{ return subpath_hits.load(); }
+	uint64_t	get_Misses() const		{ return misses.load(); }
+	uint64_t	get_Evictions() const		{ return evictions.load(); }
+};
@@ -0,0 +1,47 @@
+/* Implementation for the per-search cell state */
+
+#include "Search_state.h"
+
+Search_state::Search_state(Cell_grid& search_grid, size_t col_PT, int start_cell_ID, int end_cell_ID, const Map_snapshot* search_map) :
+	grid(search_grid), map(search_map), cols(col_PT), start_ID(start_cell_ID), end_ID(end_cell_ID) {}
+
+/* Cell for a contiguous index, created from the grid cell on first touch */
+Cell_ds& Search_state::touch(size_t contig) {
+
+	std::unordered_map<size_t, Cell_ds>::iterator it = cells.find(contig);
+	if (it != cells.end()) {
+		return it->second;
+	}
+
+	// Static data only, the search state of the new cell starts cleared
+	Cell_ds& grid_cell = grid(contig);
+	Cell_ds cell(grid_cell.get_ID(), grid_cell.get_Row_pos(), grid_cell.get_Col_pos(), cols, grid_cell.get_Xpos(), grid_cell.get_Ypos());
+
+	if (grid_cell.get_Boundary_pt() == true) {
+		cell.set_Boundary_pt();
+		cell.set_Boundary_pt_val(grid_cell.get_Boundary_pt_val());
+	}
+
+	bool obstacle = (map != nullptr) ? map->get_Obstacle(cell.get_Row_pos(), cell.get_Col_pos()) : grid_cell.get_Obstacle();
+	if (obstacle == true) {
+		cell.set_Obstacle();
+	}
+	if (cell.get_ID() == start_ID) {
+		cell.set_Start();
+	}
+	if (cell.get_ID() == end_ID) {
+		cell.set_End();
+	}
+
+	return cells.emplace(contig, cell).first->second;
+}
+
+/* Cell if the search touched it, else nullptr */
+Cell_ds* Search_state::find(size_t contig) {
+
+	std::unordered_map<size_t, Cell_ds>::iterator it = cells.find(contig);
+	if (it == cells.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
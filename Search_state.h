@@ -0,0 +1,58 @@
+#pragma once
+
+/* Per-search cell state
+- A search keeps its costs, parent and priority list flags, from cell IDs and path flags in its own Search_state instead of the
+  shared grid cells, so the grid is only read during a search. Several searches can run on the same grid at the same time (each
+  with its own state) and nothing has to be reset between searches.
+- Cells are created on first touch from the static data of the grid cell (ID, position, boundary value). The obstacle flag comes
+  from the map snapshot if the search has one, else from the grid cell. Only touched cells are stored, in a hash map, so references
+  to cells stay valid for the whole search (the parent pointer and pt_A/pt_B rely on this).
+- The start and end cells are flagged from the IDs given to the constructor, start/end flags on the grid cells are not copied.
+- The grid must not be changed while searches use it, and the paged grid (GRID_LAYOUT 2) can only be used from one thread. */
+
+/* Include external modules */
+#include <iostream>
+#include <unordered_map>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "Map_snapshot.h"
+
+class Search_state {
+
+private:
+	Cell_grid&				grid;
+	const Map_snapshot*			map;			// Obstacle flags for the search (nullptr = grid cells)
+	size_t					cols;
+	int					start_ID, end_ID;
+	std::unordered_map<size_t, Cell_ds>	cells;			// Touched cells by contiguous index (cell ID)
+
+	/* Cell for a contiguous index, created from the grid cell on first touch */
+	Cell_ds&	touch(size_t contig);
+
+public:
+
+	/* Constructors and destructors */
+	Search_state(Cell_grid& search_grid, size_t col_PT, int start_cell_ID, int end_cell_ID, const Map_snapshot* search_map);
+
+	Search_state(const Search_state&) = delete;
+	Search_state& operator=(const Search_state&) = delete;
+
+	/* Cell access with row and collumn index or row-major contiguous index (cell ID), same as the grid */
+	Cell_ds&	operator()(size_t i, size_t j)		{ return touch((i * cols) + j); }
+	Cell_ds&	operator()(size_t contig)		{ return touch(contig); }
+
+	/* Cell if the search touched it, else nullptr (for plotting without creating cells) */
+	Cell_ds*	find(size_t contig);
+
+	/* Getters */
+	const Map_snapshot*	get_Map() const			{ return map; }
+	int			get_Start_ID() const		{ return start_ID; }
+	int			get_End_ID() const		{ return end_ID; }
+	size_t			get_No_of_cells() const		{ return cells.size(); }
+};
@@ -35,6 +35,9 @@
 /* Include external modules */
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 /* Include library API */
 #include "SL_Comptime_Interface.h"
@@ -42,7 +45,14 @@
 
 /* Include any internal APIs*/
 #include "Cell_ds.h"
+#include "Cell_grid.h"
 #include "A_star_functions.h"
+#include "Component_labels.h"
+#include "Cooperative_planner.h"
+#include "Landmark_heuristic.h"
+#include "Map_snapshot.h"
+#include "Path_cache.h"
+#include "Search_state.h"
 
 /* Notes:
 Steps:
@@ -87,277 +97,222 @@ int main() {
 	Note, test this with a stack array variant as interested in difference of speed */ 
 
 	// DYN_C2D is a contigious memory 2D dynamic array (std::vector< std::vector <primitive type> > is NOT contigious)
-	RMF::DYN_C2D<Cell_ds> grid(col_PT);		// Construct 2D contiguous array from MF library with collumns known
+	// Cell_grid is DYN_C2D or the tiled layout depending on GRID_LAYOUT (Cell_grid.h)
+	Cell_grid grid(col_PT);		// Construct 2D contiguous array from MF library with collumns known
 											// (rows defined when constructing Cell_ds entites with parameters when defining grid)
 	
 	
+#if GRID_LAYOUT==2
+	// Paged grid: no map file (obstacles are generated below), spill file for evicted tiles and tiles kept in memory
+	grid.open("", "grid_spill.bin", 64);
+#endif
+
 	/* -------------------------- Function to generate grid with cell data -------------------------- */
 	grid_generation(grid, row_PT, col_PT, spacing);
 
 
 	/* -------------------------- Set start and end points (point A and B) -------------------------- */
 	
-	// This is so the point knows it is the start and end  
+	// This is so the point knows it is the start and end (for the obstacle generation and the plot, the search is given the 
+	// cell IDs and keeps its own start/end flags and costs in its Search_state)
 	grid(start_pt[0], start_pt[1]).set_Start();	
 	grid(end_pt[0]	, end_pt[1]).set_End();
 
-	// Let the start point know its a parent (For plot checks that the algorithm ended and started at the correct points (A and B),
-	// really only relevant for pt B as its guaranteed for A but just for plot tidiness)
-	grid(start_pt[0], start_pt[1]).set_Parent_eval(true);
-
-	// Containers for start and end point values to reference
-	Cell_ds pt_A = grid(start_pt[0], start_pt[1]);		
-	Cell_ds pt_B = grid(end_pt[0], end_pt[1]); 
-
-	/* -------------------------- Set first parent cell as start cell -------------------------- */
-	Cell_ds* parent_pt = &pt_A;				// Parent_pt is a pointer which switches from difernt cells (should do that, currently pointing to container for parent cell after the initial condition)..
-	std::vector<Cell_ds> container_for_parent_cell;		// Need to optomize this out if using a vector of possible parent cells is not good. 
-
-	// Calculate costs from initial condition parent and start end points for referencing
-	pt_A.set_Gcost(0); 
-	pt_A.generate_heurcost(pt_B, diag_movement, adj_movement);
-	pt_A.generate_fcost();
-	
-	parent_pt->set_Gcost(0);
-	parent_pt->generate_heurcost(pt_B, diag_movement, adj_movement); 
-	parent_pt->generate_fcost();
+	int start_ID	= grid(start_pt[0], start_pt[1]).get_ID();
+	int end_ID	= grid(end_pt[0], end_pt[1]).get_ID();
 
 	/* -------------------------------  Obstacle generation function ------------------------------------------- */
 	// Note, this is after the start and end points are defined as you do not, do not, want to make them an obstacle.. (I did)
 	obstacle_generation(grid, row_PT, col_PT, 1);
 
-	/*------------------------------- Initalize a priority list ----------------------------------*/
-	/*Choose which cell to evaluate next based on smallest fcost/hcosts
-	This has elements added to it (cells) as the algorithm progresses */
-
-	std::vector<Cell_ds> priority_list;	
-	size_t				 priolist_index = 0;
-	
-	// Reserve memory of the maximum size the priority list can be
-	priority_list.reserve(col_PT * row_PT);		
-	
-	// Initialize iteration counter
-	int iteration = 0; 
-
-	/* ------------------------------ Start of A* search algorithm ------------------------------ */
-
-	while (parent_pt->get_isEnd() == false) {
-
-		// Predefine index of parent cell 
-		size_t p_row = parent_pt->get_Row_pos(); 
-		size_t p_col = parent_pt->get_Col_pos();
-		
-		/* Get points surrounding current_pt (will be 8 points including diagonals if parent is not a boundary cell) */
-		/* Boundary cell filtering -> boundary cells must be treated differently as the available neighbouring cells are different*/
-
-		// Switch for different types of boundaries
-		/* B_IDs :	Normal cell = 0
-					BL corner	= 1
-					B edge		= 2
-					BR corner	= 3
-					L edge		= 4
-					R edge		= 5
-					TL corner	= 6
-					T edge		= 7
-					TR corner	= 8
-		*/
-
-		switch (parent_pt->get_Boundary_pt_val()) {
-			case 0: {	// Normal cell
-
-				// Indexed lrow_lim[0], urow_lim[1], lcol_lim[2], lcol_lim[3]
-				size_t neighbour_limits[4]{ p_row - 1, p_row + 1, p_col - 1, p_col + 1 };
-
-				// void A_star_algorithm(size_t(&loop_index)[4], RMF::DYN_C2D<Cell_ds> & grid, std::vector<Cell_ds> & priority_list, size_t & priolist_index, Cell_ds & parent_pt, Cell_ds & pt_B, const size_t & p_col, const size_t & p_row, const int& diag_movement, const int& adj_movement)				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 1: {	// Bottom left corner cell (do not consider points at row - 1, col - 1 area) 
+	/* Components, landmarks and map snapshots keep per-cell tables in RAM (1-4 bytes per cell each), which for the paged layout
+	would be about as large as the map itself, so they are only built for the in-memory layouts */
+	const Component_labels*		search_components = nullptr;
+	const Landmark_heuristic*	search_landmarks = nullptr;
+
+#if GRID_LAYOUT!=2
+	/* ------------------------------- Connected component labelling ------------------------------------------- */
+	// Label the passable cells so an end point walled off from the start point is rejected without searching 
+	// (cells changed after the map store exists are published through it and the labels follow with components.apply_edits)
+	Component_labels components;
+	components.label_components(grid, row_PT, col_PT, std::thread::hardware_concurrency());
+	search_components = &components;
+
+	/* ------------------------------- Landmark (ALT) heuristic preprocessing ------------------------------------------- */
+	// Better informed heuristic for maze-like maps (must be preprocessed again if cells are changed)
+	Landmark_heuristic landmarks;
+	landmarks.preprocess(grid, row_PT, col_PT, 4, diag_movement, adj_movement, std::thread::hardware_concurrency());
+	std::cout << " Landmarks: " << landmarks.get_No_of_landmarks() << ", preprocessing: " << landmarks.get_Preprocess_ms() 
+		<< " ms, " << landmarks.get_Bytes_per_landmark() << " bytes per landmark\n";
+	search_landmarks = &landmarks;
+
+	/* ------------------------------- Map snapshot ------------------------------------------- */
+	// Searches read obstacles from an immutable snapshot, so obstacle edits (map_store.publish) can be made while searches run
+	Map_store map_store(grid, row_PT, col_PT);
+	int map_reader = map_store.register_reader();
+	if (map_reader == -1) {
+		std::cout << "Error. Could not register a map reader.\n";
+		exit(-1);
+	}
+#endif
 
-				size_t neighbour_limits[4]{ p_row, p_row + 1, p_col , p_col + 1 };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 2: {	// Bottom edge 
+	/*------------------------------- Search limits ----------------------------------*/
+	/* Deadline, node-expansion budget and cancellation token so a bad query (e.g. unreachable end point on a huge grid) 
+	cannot block the calling thread. The limits are checked every check_interval expansions. */
+	std::atomic<bool> cancel_search(false);
+
+	Search_limits limits;
+	limits.deadline		= std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	limits.max_expansions	= row_PT * col_PT;
+	limits.cancel_token	= &cancel_search;
+
+	/* ------------------------------ Path cache ------------------------------ */
+	// Repeated queries (or queries on a cached path) against an unchanged map are answered from the cache. 
+	// With a map store the cache takes its map version from it (published snapshots move it on), so queries are keyed on the snapshot version. 
+	Path_cache path_cache(16, 1024);
+#if GRID_LAYOUT!=2
+	components.set_Path_cache(&path_cache);
+	map_store.set_Path_cache(&path_cache);
+#endif
 
-				size_t neighbour_limits[4]{ p_row, p_row + 1, p_col - 1, p_col + 1 };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 3: {	// Bottom right corner 
+	/* The map snapshot is pinned for the search, the landmark comparison and the plot. The guard is closed (end of this block) 
+	before the reader slot is given back, else it would unpin a slot another reader may have registered since */
+	{
+		/* ------------------------------ A* search algorithm ------------------------------ */
+		// One snapshot for the cache lookup and the search (pinned until the end of this block), the query is keyed on its version
+#if GRID_LAYOUT!=2
+		Map_store::Read_guard map_guard(map_store, map_reader);
+		const Map_snapshot* search_map = map_guard.get();
+		Path_query query{ search_map->get_Version(), start_ID, end_ID, diag_movement, adj_movement };
+#else
+		const Map_snapshot* search_map = nullptr;		// Obstacles are read from the paged grid
+		Path_query query{ path_cache.get_Map_version(), start_ID, end_ID, diag_movement, adj_movement };
+#endif
 
-				size_t neighbour_limits[4]{ p_row, p_row + 1, p_col - 1, p_col };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 4: {	// Left edge 
+		// The search keeps its costs and flags in its own state, the grid is only read
+		Search_state search_state(grid, col_PT, start_ID, end_ID, search_map);
 
-				size_t neighbour_limits[4]{ p_row - 1, p_row + 1, p_col, p_col + 1 };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
+		Search_outcome outcome;
+		if (path_cache.lookup(query, outcome.path_cell_IDs) == true) {
+			outcome.result = Search_result::found;
+		}
+		else {
+			outcome = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, limits, search_components, search_landmarks);
+			if (outcome.result == Search_result::found) {
+				path_cache.insert(query, outcome.path_cell_IDs);
 			}
-			case 5: {	// Right edge
+		}
+		for (size_t p = 0; p < outcome.path_cell_IDs.size(); p++) {
+			search_state(outcome.path_cell_IDs[p]).set_Plot_path_activator();
+		}
 
-				size_t neighbour_limits[4]{ p_row - 1, p_row + 1, p_col -1, p_col };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 6: {	// Top left corner 
+#if GRID_LAYOUT!=2
+		/* ------------------------------ Landmark heuristic comparison ------------------------------ */
+		// The same query searched again (not from the cache) without and with the landmarks, each with its own state
+		Search_state plain_state(grid, col_PT, start_ID, end_ID, search_map);
+		Search_outcome plain_outcome = A_star_search(plain_state, row_PT, col_PT, diag_movement, adj_movement, limits, search_components, nullptr);
 
-				size_t neighbour_limits[4]{ p_row - 1, p_row, p_col, p_col + 1 };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 7: {	// Top edge
+		Search_state landmark_state(grid, col_PT, start_ID, end_ID, search_map);
+		Search_outcome landmark_outcome = A_star_search(landmark_state, row_PT, col_PT, diag_movement, adj_movement, limits, search_components, &landmarks);
 
-				size_t neighbour_limits[4]{ p_row - 1, p_row, p_col - 1, p_col + 1 };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
-			case 8: {	// Top right corner
+		std::cout << "\n Expansions without landmarks: " << plain_outcome.expansions << ", with landmarks: " << landmark_outcome.expansions << "\n";
+#endif
 
-				size_t neighbour_limits[4]{ p_row - 1, p_row, p_col - 1, p_col };
-				A_star_algorithm(neighbour_limits, grid, priority_list, priolist_index, parent_pt, pt_B, p_col, p_row, diag_movement, adj_movement);
-				break;
-			}
+		/* ----------------------------- POST PROCESSING ------------------------------------------------ */
+		switch (outcome.result) {
+			case Search_result::found:		std::cout << "\n\n Path found after " << outcome.expansions << " expansions\n"; break;
+			case Search_result::unreachable:	std::cout << "\n\n End point is unreachable, showing best partial path\n"; break;
+			case Search_result::budget_exceeded:	std::cout << "\n\n Search budget exceeded, showing best partial path\n"; break;
+			case Search_result::cancelled:		std::cout << "\n\n Search cancelled, showing best partial path\n"; break;
 		}
 
-		/* Select new parent cell for the minimum fcost -> minimum hcost if fcosts are the same */
-		container_for_parent_cell = min_FHcost(priority_list, parent_pt, pt_A);	// Not ideal, but using vector for possible optimizations of code structure later
-		parent_pt = &container_for_parent_cell[0];				// Set parent cell pointer to the new parent cell. 
-
-#if DEBUG==0 
-		// Print fcost values of priority list 
-		for (size_t ip = 0; ip < priority_list.size(); ip++) {
-			std::cout << "Fcost of cell " << priority_list[ip].get_ID() << " : " << priority_list[ip].get_Fcost() << "\n"; 
-			std::cout << "Hcost of cell " << priority_list[ip].get_ID() << " : " << priority_list[ip].get_Hcost() << "\n";
-		}
+#if GRID_LAYOUT==2
+		// Tile cache metrics
+		std::cout << " Tile hits: " << grid.get_Metrics().tile_hits << ", misses: " << grid.get_Metrics().tile_misses 
+			<< ", read-ahead hits: " << grid.get_Metrics().readahead_hits << ", spilled: " << grid.get_Metrics().tiles_spilled 
+			<< ", clean evictions: " << grid.get_Metrics().clean_evictions << ", I/O stall: " << grid.get_Metrics().io_stall_ms << " ms\n";
 #endif
-		/* Set new parent cell to acknoledge it is a parent cell.*/
-		// Note, cell ID is the same as contiguous index for DYN_C2D object "grid" since ID is 0 -> N cells and contig ind is 0 -> N cells.
-		grid(parent_pt->get_ID()).set_Parent_eval(true);
-		priority_list[parent_pt->get_Priolist_index()].set_Parent_eval(true);
-
-		/* NOTES: 
-		-	When the end cell (target or whatever) is met, the while condition is checked. Therefore, the end cell is actually not calculated.
-			But the new parent (which will be the end cell) knows the parent it comes from, i.e. the path, so is fine. Just weird for plotting i guess
-		-   NEED A FUNCTION TO CLEAR THE PRIORITY LIST OF REDUNDENT CELLS to avoid excess looping over list*/
-
-		// Iteration logger 
-		iteration += 1;
-		std::cout << "Iteration: " << iteration << "\n\n";
-		if (iteration > 10000) {
-			std::cin.get(); 
-		}
 
-		/* "Real time" plot grid using ASCII characters for console.. need a better plotter */
-#if DEBUG==0
+		/* ----------------------------------------------- Plot the path --------------------------------------------- */
+
+		// Print display output verbose 
+		std::cout << "\n\n Path the A* algorithm found: \n";
+
+		/* Plot grid using ASCII characters for console.. need a better plotter */
+		// Search flags come from the search state (cells the search never touched have none), start/end and obstacles from the grid
 		for (int i_plot = 0; i_plot < row_PT; i_plot++) {
 
 			std::cout << "| ";
 
 			for (int j_plot = 0; j_plot < col_PT; j_plot++) {
 
+				Cell_ds* search_cell = search_state.find((i_plot * col_PT) + j_plot);
+				bool start_or_end = grid(i_plot, j_plot).get_isStart() == true || grid(i_plot, j_plot).get_isEnd() == true;
+		
 				// Plot start and end poitns with them beign a parent at one point (i.e. the algorithm works, this is just to check for bugs) 
-				if ((grid(i_plot, j_plot).get_isStart() == true && grid(i_plot, j_plot).get_Parent_eval() == true) || (grid(i_plot, j_plot).get_isEnd() == true && grid(i_plot, j_plot).get_Parent_eval() == true)) {
-					std::cout << "@ "; 
+				if (start_or_end == true && search_cell != nullptr && search_cell->get_Parent_eval() == true) {
+					std::cout << "@ ";
 				}
-				// Plot start and end points (If not the above then there is a problem)
-				else if (grid(i_plot, j_plot).get_isStart() == true || grid(i_plot, j_plot).get_isEnd() == true) {
+				// Plot start and end points  (If not the above then there is a problem)
+				else if (start_or_end == true) {
 					std::cout << "% ";
 				}
-				// If cell is a parent
-				else if (grid(i_plot, j_plot).get_Parent_eval() == true) {
+				// Plot the path points
+				else if (search_cell != nullptr && search_cell->get_Plot_path_activator() == true) {
+					std::cout << "& "; 
+				}
+				// If cell was a parent
+				else if (search_cell != nullptr && search_cell->get_Parent_eval() == true) {
 					std::cout << "P ";
 				}
 				// If cell has been evaluated 
-				else if (grid(i_plot, j_plot).get_On_priolist() == true) {
+				else if (search_cell != nullptr && search_cell->get_On_priolist() == true) {
 					std::cout << "A ";
 				}
 				else if (grid(i_plot, j_plot).get_Obstacle() == true) {
 					std::cout << (char)254u << " ";
 				}
-
 				else {
 					std::cout << ". ";
 				}
 			}
+
 			// Next row 
 			std::cout << "|\n";
 		}
-#endif
-
-	} // End of while loop for finding target/end point of algorithm. 
-
-
-	/* ----------------------------- POST PROCESSING ------------------------------------------------ */
-	/* -------------------------- Establish path from cell IDs -------------------------------------- */
-
-	// Pointer to current end grid cell (which is, hopefully, in this container, as all parents were)
-	Cell_ds* backtrack_cell_pointer = &container_for_parent_cell[0]; 
-	
-	// Initialize vector to contain all path cell IDs and reserve memory 
-	std::vector<int> path_cell_IDs; 
-	path_cell_IDs.reserve(row_PT* col_PT);
-
-	// Store cell ID of target cell for plotting
-	path_cell_IDs.push_back(backtrack_cell_pointer->get_ID());
-
-	// While loop where the condition is if it is the start cell (which the grid cells are aware of) 
-	while (backtrack_cell_pointer->get_isStart() == false) {
-
-		// Get the ID of the parent cell of current cell backtrack_cell_pointer is pointing too. 
-		int from_parent_cell_ID = backtrack_cell_pointer->get_From_Cell_ID();
-		path_cell_IDs.push_back(from_parent_cell_ID);				// Store path cell ID 
-
-		// Point to the parent cell of the current cell and repeat until the start point is reached. 
-		backtrack_cell_pointer = &grid(from_parent_cell_ID);
-		backtrack_cell_pointer->set_Plot_path_activator();			// Set the cell to plot when called by the plotter
 	}
 
-	/* ----------------------------------------------- Plot the path --------------------------------------------- */
-
-	// Print display output verbose 
-	std::cout << "\n\n Path the A* algorithm found: \n";
-
-	/* Plot grid using ASCII characters for console.. need a better plotter */
-	for (int i_plot = 0; i_plot < row_PT; i_plot++) {
-
-		std::cout << "| ";
-
-		for (int j_plot = 0; j_plot < col_PT; j_plot++) {
-		
-			// Plot start and end poitns with them beign a parent at one point (i.e. the algorithm works, this is just to check for bugs) 
-			if ((grid(i_plot, j_plot).get_isStart() == true && grid(i_plot, j_plot).get_Parent_eval() == true) || (grid(i_plot, j_plot).get_isEnd() == true && grid(i_plot, j_plot).get_Parent_eval() == true)) {
-				std::cout << "@ ";
-			}
-			// Plot start and end points  (If not the above then there is a problem)
-			else if (grid(i_plot, j_plot).get_isStart() == true || grid(i_plot, j_plot).get_isEnd() == true) {
-				std::cout << "% ";
-			}
-			// Plot the path points
-			else if (grid(i_plot, j_plot).get_Plot_path_activator() == true) {
-				std::cout << "& "; 
-			}
-			// If cell was a parent
-			else if (grid(i_plot, j_plot).get_Parent_eval() == true) {
-				std::cout << "P ";
-			}
-			// If cell has been evaluated 
-			else if (grid(i_plot, j_plot).get_On_priolist() == true) {
-				std::cout << "A ";
-			}
-			else if (grid(i_plot, j_plot).get_Obstacle() == true) {
-				std::cout << (char)254u << " ";
-			}
-			else {
-				std::cout << ". ";
-			}
+	/* ------------------------------ Cooperative multi-agent planning ------------------------------ */
+	// Agents from the free cells of the bottom row to the free cells of the top row (in reverse order, so their routes cross), 
+	// planned with windowed cooperative A* so they do not collide
+	Cooperative_planner planner(grid, row_PT, col_PT, diag_movement, adj_movement, 4, 2);
+	std::vector<size_t> agent_starts, agent_goals;
+	for (int j = 0; j < col_PT; j++) {
+		if (grid(row_PT - 1, j).get_Obstacle() == false) {
+			agent_starts.push_back(((size_t)(row_PT - 1) * col_PT) + j);
 		}
+		if (grid(0, j).get_Obstacle() == false) {
+			agent_goals.insert(agent_goals.begin(), (size_t)j);
+		}
+	}
+	for (size_t a = 0; a < agent_starts.size() && a < agent_goals.size() && a < 4; a++) {
+		planner.add_agent(agent_starts[a], agent_goals[a]);
+	}
 
-		// Next row 
-		std::cout << "|\n";
+	size_t agents_at_goal = 0;
+	while (agents_at_goal < planner.get_No_of_agents() && planner.get_Time() < 10 * (uint64_t)(row_PT + col_PT)) {
+		planner.tick();
+		agents_at_goal = 0;
+		for (size_t a = 0; a < planner.get_No_of_agents(); a++) {
+			agents_at_goal += (planner.get_Agent_at_goal(a) == true) ? 1 : 0;
+		}
 	}
+	std::cout << "\n Agents: " << planner.get_No_of_agents() << ", at goal: " << agents_at_goal << " after " << planner.get_Time() 
+		<< " ticks, failed plans: " << planner.get_Failed_plans() << ", collisions: " << planner.get_Collisions() << "\n";
+
+#if GRID_LAYOUT!=2
+	map_store.unregister_reader(map_reader);
+#endif
 }
 
 
@@ -0,0 +1,132 @@
+/* Include external modules */
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/* Include any internal APIs*/
+#include "Thread_affinity.h"
+
+/* NUMA node with CPUs */
+struct Numa_node {
+	int			id;			// System node ID
+	std::vector<int>	cpus;			// Linux only, Windows asks for the node mask when pinning
+};
+
+#if defined(__linux__)
+/* Parse a sysfs cpulist or nodelist ("0-3,8-11") */
+static std::vector<int> parse_cpulist(const std::string& cpulist) {
+
+	std::vector<int> cpus;
+	std::stringstream ranges(cpulist);
+	std::string range;
+
+	while (std::getline(ranges, range, ',')) {
+
+		if (range.empty() == true) {
+			continue;
+		}
+		size_t dash = range.find('-');
+		int first = std::stoi(range.substr(0, dash));
+		int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+		for (int cpu = first; cpu <= last; cpu++) {
+			cpus.push_back(cpu);
+		}
+	}
+	return cpus;
+}
+
+/* First line of a sysfs file (empty if it cannot be read) */
+static std::string read_sysfs_line(const std::string& path) {
+
+	std::ifstream sysfs_file(path);
+	std::string line;
+	if (sysfs_file.is_open() == true) {
+		std::getline(sysfs_file, line);
+	}
+	return line;
+}
+#endif
+
+/* Nodes with CPUs in order of their system ID, read once */
+static const std::vector<Numa_node>& numa_nodes() {
+
+	static const std::vector<Numa_node> nodes = []() {
+
+		std::vector<Numa_node> found_nodes;
+#if defined(_WIN32)
+		ULONG highest_node = 0;
+		if (GetNumaHighestNodeNumber(&highest_node) == TRUE) {
+			for (ULONG node = 0; node <= highest_node; node++) {
+				GROUP_AFFINITY node_mask = {};
+				if (GetNumaNodeProcessorMaskEx((USHORT)node, &node_mask) == TRUE && node_mask.Mask != 0) {
+					found_nodes.push_back(Numa_node{ (int)node, std::vector<int>() });
+				}
+			}
+		}
+#elif defined(__linux__)
+		// Node IDs from the node lists (not by counting node0, node1, .. as the numbering can have gaps)
+		std::string nodelist = read_sysfs_line("/sys/devices/system/node/has_cpu");
+		if (nodelist.empty() == true) {
+			nodelist = read_sysfs_line("/sys/devices/system/node/online");
+		}
+		std::vector<int> node_ids = parse_cpulist(nodelist);
+
+		for (size_t n = 0; n < node_ids.size(); n++) {
+			std::vector<int> cpus = parse_cpulist(read_sysfs_line("/sys/devices/system/node/node" + std::to_string(node_ids[n]) + "/cpulist"));
+			if (cpus.empty() == false) {
+				found_nodes.push_back(Numa_node{ node_ids[n], cpus });		// Memory only nodes are skipped
+			}
+		}
+#endif
+		return found_nodes;
+	}();
+	return nodes;
+}
+
+/* Number of NUMA nodes with CPUs (1 if unknown) */
+size_t get_No_of_numa_nodes() {
+
+	size_t no_of_nodes = numa_nodes().size();
+	return (no_of_nodes > 0) ? no_of_nodes : 1;
+}
+
+/* System node ID of the node-th NUMA node with CPUs */
+int get_Numa_node_id(size_t node) {
+
+	const std::vector<Numa_node>& nodes = numa_nodes();
+	return (node < nodes.size()) ? nodes[node].id : -1;
+}
+
+/* Pin the calling thread to the CPUs of the node-th NUMA node with CPUs */
+bool pin_thread_to_numa_node(size_t node) {
+
+	const std::vector<Numa_node>& nodes = numa_nodes();
+	if (node >= nodes.size()) {
+		return false;
+	}
+
+#if defined(_WIN32)
+	GROUP_AFFINITY node_mask = {};
+	if (GetNumaNodeProcessorMaskEx((USHORT)nodes[node].id, &node_mask) == FALSE || node_mask.Mask == 0) {
+		return false;
+	}
+	return SetThreadGroupAffinity(GetCurrentThread(), &node_mask, nullptr) != FALSE;
+#elif defined(__linux__)
+	cpu_set_t cpu_mask;
+	CPU_ZERO(&cpu_mask);
+	for (size_t c = 0; c < nodes[node].cpus.size(); c++) {
+		CPU_SET(nodes[node].cpus[c], &cpu_mask);
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpu_mask), &cpu_mask) == 0;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+/* Pinning threads to NUMA nodes
+- Used by the first touch in Tiled_C2D::reserve so each band of tile rows is zeroed (and therefore placed) by a thread
+  running on a fixed node, instead of wherever the scheduler happens to run the thread.
+- Linux reads the nodes with CPUs from sysfs (has_cpu, or online if it is missing) and the CPU list of each, Windows uses the 
+  NUMA processor masks. Node numbers can have gaps (e.g. node0 and node2) and memory only nodes have no CPUs, so nodes are 
+  addressed by their index in the list of nodes with CPUs (0 to get_No_of_numa_nodes() - 1) and keep their system node ID.
+- Other platforms (or hosts without NUMA information) report a single node and pinning does nothing. */
+
+/* Include external modules */
+#include <cstddef>
+
+/* Number of NUMA nodes with CPUs (1 if unknown) */
+size_t	get_No_of_numa_nodes();
+
+/* System node ID of the node-th NUMA node with CPUs (-1 if there is no such node) */
+int	get_Numa_node_id(size_t node);
+
+/* Pin the calling thread to the CPUs of the node-th NUMA node with CPUs, returns false if the thread could not be pinned */
+bool	pin_thread_to_numa_node(size_t node);
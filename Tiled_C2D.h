@@ -0,0 +1,129 @@
+#pragma once
+
+/* Tiled 2D array (drop in for RMF::DYN_C2D in the grid functions)
+- Elements are stored in square TILE x TILE blocks (tiles are row-major, elements inside a tile are row-major) so a search 
+  frontier moving vertically stays in the same cache lines/pages for TILE rows instead of touching a new one every row. 
+- Indexing with (row, col) or the row-major contiguous index (cell ID) is mapped to the tile position, so code using 
+  grid(i, j) or grid(cell_ID) does not need to know about the layout. 
+- Memory is allocated untouched and then first touched (zeroed) by a band of tile rows per thread, so on multi-socket hosts 
+  the pages are spread over the NUMA nodes of the threads instead of all landing on the node of the thread that constructs the cells. 
+  Each touch thread is pinned to a node (consecutive bands share a node), so where a band lands does not depend on the scheduler. */
+
+/* Include external modules */
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+/* Include any internal APIs*/
+#include "Thread_affinity.h"
+
+template <typename T, size_t TILE = 8>
+class Tiled_C2D {
+
+	static_assert(TILE > 0 && (TILE & (TILE - 1)) == 0, "Tile size must be a power of two");
+
+private:
+	static constexpr size_t	tile_area	= TILE * TILE;
+	static constexpr size_t	page_align	= 4096;
+
+	T*			data;				// Raw tile storage (elements constructed with placement new)
+	size_t			rows, cols;			// Logical size of the array 
+	size_t			tiles_per_row, tile_rows;	// Number of tiles in each direction (edge tiles are padded)
+	size_t			no_of_elements;			// Number of constructed elements (constructed in row-major order)
+
+	/* Map a row and collumn to the position in the tiled storage */
+	size_t tile_index(size_t i, size_t j) const {
+		size_t tile = ((i / TILE) * tiles_per_row) + (j / TILE);
+		return (tile * tile_area) + ((i & (TILE - 1)) * TILE) + (j & (TILE - 1));
+	}
+
+	/* Destroy constructed elements and free storage */
+	void release() {
+		if (data == nullptr) {
+			return;
+		}
+		for (size_t c = 0; c < no_of_elements; c++) {
+			data[tile_index(c / cols, c % cols)].~T();
+		}
+		::operator delete(data, std::align_val_t(page_align));
+		data = nullptr;
+		no_of_elements = 0;
+	}
+
+public:
+
+	/* Constructors and destructors */
+	// Collumns known (rows defined when reserving, same as DYN_C2D)
+	Tiled_C2D(size_t col_size) :
+		data(nullptr), rows(0), cols(col_size), tiles_per_row(0), tile_rows(0), no_of_elements(0) {}
+
+	~Tiled_C2D() { release(); }
+
+	// Not copyable, the grid is large and cells are referenced by pointer during the search
+	Tiled_C2D(const Tiled_C2D&) = delete;
+	Tiled_C2D& operator=(const Tiled_C2D&) = delete;
+
+	/* Allocate storage for row_size x col_size elements and first touch it.
+	- n_touch_threads = 0 uses one thread per hardware thread */
+	void reserve(size_t row_size, size_t col_size, size_t n_touch_threads = 0) {
+
+		release();
+
+		rows = row_size;
+		cols = col_size;
+		tiles_per_row	= (cols + TILE - 1) / TILE;
+		tile_rows	= (rows + TILE - 1) / TILE;
+
+		size_t tile_row_bytes = tiles_per_row * tile_area * sizeof(T);
+		data = static_cast<T*>(::operator new(tile_rows * tile_row_bytes, std::align_val_t(page_align)));
+
+		// First touch, one band of tile rows per thread. Bands are handed out to the NUMA nodes with CPUs in order (band b on 
+		// the (b * nodes / bands)-th node, whatever its system ID) and each thread is pinned to its node before touching its band
+		if (n_touch_threads == 0) {
+			n_touch_threads = std::thread::hardware_concurrency();
+		}
+		if (n_touch_threads < 1) {
+			n_touch_threads = 1;
+		}
+		if (n_touch_threads > tile_rows) {
+			n_touch_threads = tile_rows;
+		}
+		size_t band_tile_rows = (tile_rows + n_touch_threads - 1) / n_touch_threads;
+		size_t no_of_bands = (tile_rows + band_tile_rows - 1) / band_tile_rows;
+		size_t no_of_nodes = get_No_of_numa_nodes();
+
+		std::vector<std::thread> workers;
+		workers.reserve(n_touch_threads);
+		for (size_t tr_begin = 0; tr_begin < tile_rows; tr_begin += band_tile_rows) {
+			size_t tr_end = (tr_begin + band_tile_rows < tile_rows) ? tr_begin + band_tile_rows : tile_rows;
+			char* band_begin = reinterpret_cast<char*>(data) + (tr_begin * tile_row_bytes);
+			size_t band_bytes = (tr_end - tr_begin) * tile_row_bytes;
+			size_t node = ((tr_begin / band_tile_rows) * no_of_nodes) / no_of_bands;
+			workers.emplace_back([band_begin, band_bytes, node]() {
+				pin_thread_to_numa_node(node);
+				std::memset(band_begin, 0, band_bytes);
+			});
+		}
+		for (size_t t = 0; t < workers.size(); t++) {
+			workers[t].join();
+		}
+	}
+
+	/* Construct the next element in row-major order (same order as DYN_C2D, collumn index kept for the same interface) */
+	void element_emplace_back(const T& object, size_t col_index) {
+		(void)col_index;
+		size_t c = no_of_elements;
+		new (&data[tile_index(c / cols, c % cols)]) T(object);
+		no_of_elements += 1;
+	}
+
+	/* Element access with row and collumn index or row-major contiguous index */
+	T&		operator()(size_t i, size_t j)			{ return data[tile_index(i, j)]; }
+	const T&	operator()(size_t i, size_t j) const		{ return data[tile_index(i, j)]; }
+	T&		operator()(size_t contig)			{ return data[tile_index(contig / cols, contig % cols)]; }
+	const T&	operator()(size_t contig) const			{ return data[tile_index(contig / cols, contig % cols)]; }
+
+	size_t		get_Rows() const				{ return rows; }
+	size_t		get_Cols() const				{ return cols; }
+};
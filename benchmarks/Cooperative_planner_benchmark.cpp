@@ -0,0 +1,88 @@
+/* Cooperative planner benchmark, agents planned per second as the fleet grows
+- A map with randomly placed obstacles (about one in ten cells) gets fleets of 16 up to 1024 agents with random start and goal
+  cells. Every fleet runs the same number of ticks with the same window and replan interval.
+- Prints agents planned per second (planning time only), mean ms per tick, the number of goal searches (shared per goal) and
+  the failed plans and collisions of every fleet size.
+
+Build from the repository root with the RMF library headers on the include path (every .cpp in the root except Source.cpp):
+	g++ -std=c++17 -O2 -pthread -I. -I<RMF include dir> $(ls *.cpp | grep -v Source.cpp) benchmarks/Cooperative_planner_benchmark.cpp -o cooperative_planner_benchmark
+
+Usage:
+	cooperative_planner_benchmark [map size] [ticks] [window]	(defaults 128 64 8) */
+
+/* Include external modules */
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "A_star_functions.h"
+#include "Cooperative_planner.h"
+
+int main(int argc, char* argv[]) {
+
+	size_t map_size = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 128;
+	size_t ticks = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 64;
+	size_t window = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 8;
+
+	const int diag_movement = 14;
+	const int adj_movement = 10;
+
+	if (map_size < 8) {
+		std::cout << "Error. The map needs at least 8 x 8 cells.\n";
+		exit(-1);
+	}
+
+	/* Map with random obstacles */
+	Cell_grid grid(map_size);
+#if GRID_LAYOUT==2
+	grid.open("", "planner_benchmark_spill.bin", 256);
+#endif
+	grid_generation(grid, map_size, map_size, 1.0f);
+	std::mt19937 rng(17);
+	std::vector<size_t> free_cells;
+	for (size_t c = 0; c < map_size * map_size; c++) {
+		if (rng() % 10 == 0) {
+			grid(c).set_Obstacle();
+		}
+		else {
+			free_cells.push_back(c);
+		}
+	}
+
+	std::cout << " " << map_size << " x " << map_size << " map, " << ticks << " ticks, window " << window << "\n";
+	std::cout << " agents | agents planned/s | ms per tick | goal searches | failed plans | collisions\n";
+
+	for (size_t no_of_agents = 16; no_of_agents <= 1024 && no_of_agents <= free_cells.size(); no_of_agents *= 2) {
+
+		std::vector<size_t> starts = free_cells;
+		std::vector<size_t> goals = free_cells;
+		std::shuffle(starts.begin(), starts.end(), rng);
+		std::shuffle(goals.begin(), goals.end(), rng);
+
+		Cooperative_planner planner(grid, map_size, map_size, diag_movement, adj_movement, window, window / 2);
+		for (size_t a = 0; a < no_of_agents; a++) {
+			planner.add_agent(starts[a], goals[a]);
+		}
+
+		std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now();
+		for (size_t t = 0; t < ticks; t++) {
+			planner.tick();
+		}
+		double run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - run_start).count();
+
+		double agents_per_second = (planner.get_Planning_ms() > 0.0) ? planner.get_Agents_planned() / (planner.get_Planning_ms() / 1000.0) : 0.0;
+		std::cout << " " << no_of_agents << " | " << agents_per_second << " | " << run_ms / ticks << " | " << planner.get_No_of_goal_searches()
+			<< " | " << planner.get_Failed_plans() << " | " << planner.get_Collisions() << "\n";
+	}
+	return 0;
+}
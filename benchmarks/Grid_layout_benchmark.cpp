@@ -0,0 +1,238 @@
+/* Grid layout benchmark, row-major RMF::DYN_C2D (GRID_LAYOUT 0) against Tiled_C2D (GRID_LAYOUT 1) on large maps
+- Both layouts hold the same Cell_ds grid. A cell is 80 bytes so a 10k x 10k map is ~8 GB per layout, the layouts are
+  built and run one after the other (or pick one with the layout argument).
+- Access patterns, each cell visited reads itself and its 8 neighbours like the A* neighbour loop:
+	-> row sweep, cells in row-major order (best case for the row-major layout)
+	-> collumn sweep, cells in collumn-major order (a frontier moving vertically, worst case for the row-major layout)
+	-> local walk, a random walk over neighbouring cells (a frontier growing around a point)
+- Cache misses and data TLB read misses are counted with perf_event_open on Linux (needs perf_event_paranoid <= 2),
+  "n/a" is printed where the counters are not available.
+
+Build from the repository root with the RMF library headers on the include path:
+	g++ -std=c++17 -O2 -pthread -I. -I<RMF include dir> Thread_affinity.cpp benchmarks/Grid_layout_benchmark.cpp -o grid_layout_benchmark
+
+Usage:
+	grid_layout_benchmark [rows] [cols] [layout]	(defaults 10000 10000, layout 0 = row-major, 1 = tiled, otherwise both) */
+
+/* Include external modules */
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Tiled_C2D.h"
+
+/* Hardware miss counters for the calling thread */
+class Miss_counters {
+
+private:
+	int		cache_fd, tlb_fd;			// perf event file descriptors (-1 if not available)
+
+#if defined(__linux__)
+	static int open_counter(uint32_t type, uint64_t config) {
+
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size		= sizeof(attr);
+		attr.type		= type;
+		attr.config		= config;
+		attr.disabled		= 1;
+		attr.exclude_kernel	= 1;
+		attr.exclude_hv		= 1;
+		return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+#endif
+
+	static void print_count(int fd, long long count) {
+		if (fd < 0) {
+			std::cout << "n/a";
+		}
+		else {
+			std::cout << count;
+		}
+	}
+
+public:
+	Miss_counters() : cache_fd(-1), tlb_fd(-1) {
+#if defined(__linux__)
+		cache_fd = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+		tlb_fd = open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+	}
+
+	~Miss_counters() {
+#if defined(__linux__)
+		if (cache_fd >= 0) { close(cache_fd); }
+		if (tlb_fd >= 0) { close(tlb_fd); }
+#endif
+	}
+
+	void start() {
+#if defined(__linux__)
+		int fds[2] = { cache_fd, tlb_fd };
+		for (int f = 0; f < 2; f++) {
+			if (fds[f] >= 0) {
+				ioctl(fds[f], PERF_EVENT_IOC_RESET, 0);
+				ioctl(fds[f], PERF_EVENT_IOC_ENABLE, 0);
+			}
+		}
+#endif
+	}
+
+	/* Stop counting and print "cache misses, TLB misses" */
+	void stop_and_print() {
+		long long counts[2] = { 0, 0 };
+#if defined(__linux__)
+		int fds[2] = { cache_fd, tlb_fd };
+		for (int f = 0; f < 2; f++) {
+			if (fds[f] >= 0) {
+				ioctl(fds[f], PERF_EVENT_IOC_DISABLE, 0);
+				if (read(fds[f], &counts[f], sizeof(counts[f])) != (ssize_t)sizeof(counts[f])) {
+					counts[f] = 0;
+				}
+			}
+		}
+#endif
+		std::cout << "cache misses = ";
+		print_count(cache_fd, counts[0]);
+		std::cout << ", dTLB read misses = ";
+		print_count(tlb_fd, counts[1]);
+	}
+};
+
+/* Construct the cells in row-major order (as grid_generation does) with roughly one in five cells an obstacle */
+template <typename Grid>
+void build_grid(Grid& grid, size_t rows, size_t cols) {
+
+	grid.reserve(rows, cols);
+	std::mt19937 rng(7);
+	int ID = 0;
+	for (size_t i = 0; i < rows; i++) {
+		for (size_t j = 0; j < cols; j++) {
+			grid.element_emplace_back(Cell_ds(ID, i, j, cols, (float)j, (float)i), j);
+			if (rng() % 5 == 0) {
+				grid(i, j).set_Obstacle();
+			}
+			ID += 1;
+		}
+	}
+}
+
+/* Read a cell and its 8 neighbours (clamped at the walls) */
+template <typename Grid>
+inline long long read_neighbourhood(Grid& grid, size_t i, size_t j, size_t rows, size_t cols) {
+
+	long long sum = 0;
+	size_t i_begin = (i > 0) ? i - 1 : 0;
+	size_t j_begin = (j > 0) ? j - 1 : 0;
+	size_t i_end = (i + 1 < rows) ? i + 1 : i;
+	size_t j_end = (j + 1 < cols) ? j + 1 : j;
+	for (size_t n_i = i_begin; n_i <= i_end; n_i++) {
+		for (size_t n_j = j_begin; n_j <= j_end; n_j++) {
+			Cell_ds& cell = grid(n_i, n_j);
+			sum += (cell.get_Obstacle() == true) ? 1 : cell.get_Gcost();
+		}
+	}
+	return sum;
+}
+
+/* Run one access pattern and print its time and miss counts */
+template <typename Grid>
+void run_pattern(Grid& grid, size_t rows, size_t cols, int pattern, const char* name) {
+
+	Miss_counters counters;
+	long long sink = 0;
+
+	auto t_begin = std::chrono::steady_clock::now();
+	counters.start();
+
+	switch (pattern) {
+		case (0):			// Row sweep
+			for (size_t i = 0; i < rows; i++) {
+				for (size_t j = 0; j < cols; j++) {
+					sink += read_neighbourhood(grid, i, j, rows, cols);
+				}
+			}
+			break;
+
+		case (1):			// Collumn sweep
+			for (size_t j = 0; j < cols; j++) {
+				for (size_t i = 0; i < rows; i++) {
+					sink += read_neighbourhood(grid, i, j, rows, cols);
+				}
+			}
+			break;
+
+		default:			// Local walk, as many steps as cells
+		{
+			std::mt19937 rng(11);
+			size_t i = rows / 2;
+			size_t j = cols / 2;
+			for (size_t step = 0; step < rows * cols; step++) {
+				sink += read_neighbourhood(grid, i, j, rows, cols);
+				uint32_t move = rng();
+				int di = (int)(move % 3) - 1;
+				int dj = (int)((move / 3) % 3) - 1;
+				if ((di >= 0 || i > 0) && i + di < rows) { i += di; }
+				if ((dj >= 0 || j > 0) && j + dj < cols) { j += dj; }
+			}
+			break;
+		}
+	}
+
+	auto t_end = std::chrono::steady_clock::now();
+	std::cout << "  " << name << ": " << std::chrono::duration<double, std::milli>(t_end - t_begin).count() << " ms, ";
+	counters.stop_and_print();
+	std::cout << " (checksum " << sink << ")\n";
+}
+
+template <typename Grid>
+void run_layout(Grid& grid, size_t rows, size_t cols, const char* layout_name) {
+
+	auto t_begin = std::chrono::steady_clock::now();
+	build_grid(grid, rows, cols);
+	auto t_end = std::chrono::steady_clock::now();
+
+	std::cout << layout_name << " (" << rows << " x " << cols << ", built in " << std::chrono::duration<double, std::milli>(t_end - t_begin).count() << " ms)\n";
+	run_pattern(grid, rows, cols, 0, "row sweep");
+	run_pattern(grid, rows, cols, 1, "collumn sweep");
+	run_pattern(grid, rows, cols, 2, "local walk");
+}
+
+int main(int argc, char* argv[]) {
+
+	size_t rows = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+	size_t cols = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10000;
+	int layout = (argc > 3) ? std::atoi(argv[3]) : -1;
+
+	if (rows == 0 || cols == 0) {
+		std::cout << "Error. The map needs at least one row and one collumn.\n";
+		exit(-1);
+	}
+
+	if (layout != 1) {
+		RMF::DYN_C2D<Cell_ds> row_major_grid(cols);
+		run_layout(row_major_grid, rows, cols, "Row-major DYN_C2D");
+	}
+	if (layout != 0) {
+		Tiled_C2D<Cell_ds, 8> tiled_grid(cols);
+		run_layout(tiled_grid, rows, cols, "Tiled_C2D<8>");
+	}
+	return 0;
+}
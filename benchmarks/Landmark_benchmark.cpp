@@ -0,0 +1,190 @@
+/* Landmark (ALT) heuristic benchmark, expansions without and with landmarks on maze and room maps
+- Maps: room maps (walls every 10 cells with one door per wall segment) and mazes (recursive backtracker, corridors one cell
+  wide), each in two sizes.
+- The same random queries are searched with the distance-only heuristic and with K = 1, 2, 4, 8 and 16 landmarks.
+- Prints the summed expansions, the reduction against the distance-only heuristic, the search time, and the preprocessing
+  time, ms per landmark and bytes per landmark for every map and K.
+
+Build from the repository root with the RMF library headers on the include path (every .cpp in the root except Source.cpp):
+	g++ -std=c++17 -O2 -pthread -I. -I<RMF include dir> $(ls *.cpp | grep -v Source.cpp) benchmarks/Landmark_benchmark.cpp -o landmark_benchmark
+
+Usage:
+	landmark_benchmark [queries per map] [threads]	(defaults 40, hardware threads) */
+
+/* Include external modules */
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "A_star_functions.h"
+#include "Landmark_heuristic.h"
+#include "Search_state.h"
+
+/* Room map, walls every 10 cells with a door in the middle of every wall segment */
+static void build_room_map(Cell_grid& grid, size_t row_PT, size_t col_PT) {
+
+	for (size_t i = 0; i < row_PT; i++) {
+		for (size_t j = 0; j < col_PT; j++) {
+			bool wall = (i % 10 == 9 || j % 10 == 9);
+			bool door = (i % 10 == 9 && j % 10 == 4) || (j % 10 == 9 && i % 10 == 4);
+			if (wall == true && door == false) {
+				grid(i, j).set_Obstacle();
+			}
+		}
+	}
+}
+
+/* Maze, cells with even row and collumn are rooms, carved by a recursive backtracker (iterative) from the top left */
+static void build_maze_map(Cell_grid& grid, size_t row_PT, size_t col_PT, unsigned seed) {
+
+	std::vector<unsigned char> open(row_PT * col_PT, 0);
+	std::mt19937 rng(seed);
+	std::vector<std::pair<size_t, size_t>> stack;
+	stack.push_back(std::make_pair(0, 0));
+	open[0] = 1;
+
+	const int moves[4][2] = { { -2, 0 }, { 2, 0 }, { 0, -2 }, { 0, 2 } };
+	while (stack.empty() == false) {
+
+		size_t i = stack.back().first;
+		size_t j = stack.back().second;
+
+		std::vector<int> unvisited;
+		for (int m = 0; m < 4; m++) {
+			long n_i = (long)i + moves[m][0];
+			long n_j = (long)j + moves[m][1];
+			if (n_i >= 0 && n_j >= 0 && n_i < (long)row_PT && n_j < (long)col_PT && open[(n_i * col_PT) + n_j] == 0) {
+				unvisited.push_back(m);
+			}
+		}
+		if (unvisited.empty() == true) {
+			stack.pop_back();
+			continue;
+		}
+
+		int m = unvisited[rng() % unvisited.size()];
+		size_t n_i = (size_t)((long)i + moves[m][0]);
+		size_t n_j = (size_t)((long)j + moves[m][1]);
+		open[(((i + n_i) / 2) * col_PT) + ((j + n_j) / 2)] = 1;
+		open[(n_i * col_PT) + n_j] = 1;
+		stack.push_back(std::make_pair(n_i, n_j));
+	}
+
+	for (size_t c = 0; c < row_PT * col_PT; c++) {
+		if (open[c] == 0) {
+			grid(c).set_Obstacle();
+		}
+	}
+}
+
+/* Search every query, returns the summed expansions (and the search time in ms). Exits if a query is not found. */
+static size_t search_queries(Cell_grid& grid, size_t row_PT, size_t col_PT, const std::vector<std::pair<int, int>>& queries,
+	const Landmark_heuristic* landmarks, double& search_ms) {
+
+	const int diag_movement = 14;
+	const int adj_movement = 10;
+	size_t expansions = 0;
+
+	// The search logs ties of the priority list to std::cout, which is muted while searching
+	std::streambuf* cout_buffer = std::cout.rdbuf(nullptr);
+
+	std::chrono::steady_clock::time_point search_start = std::chrono::steady_clock::now();
+	for (size_t q = 0; q < queries.size(); q++) {
+
+		Search_state search_state(grid, col_PT, queries[q].first, queries[q].second, nullptr);
+		Search_outcome outcome = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, Search_limits(), nullptr, landmarks);
+		if (outcome.result != Search_result::found) {
+			std::cout.rdbuf(cout_buffer);
+			std::cout.clear();
+			std::cout << "Error. Query " << q << " was not found on a connected map.\n";
+			exit(-1);
+		}
+		expansions += outcome.expansions;
+	}
+	search_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - search_start).count();
+
+	std::cout.rdbuf(cout_buffer);
+	std::cout.clear();
+	return expansions;
+}
+
+/* Run every landmark count on one map */
+static void run_map(const char* name, bool maze, size_t map_size, size_t no_of_queries, size_t n_threads) {
+
+	const int diag_movement = 14;
+	const int adj_movement = 10;
+
+	Cell_grid grid(map_size);
+	grid_generation(grid, map_size, map_size, 1.0f);
+	if (maze == true) {
+		build_maze_map(grid, map_size, map_size, 5);
+	}
+	else {
+		build_room_map(grid, map_size, map_size);
+	}
+
+	// Queries between random free cells (both maps are connected)
+	std::mt19937 rng(9);
+	std::vector<std::pair<int, int>> queries;
+	while (queries.size() < no_of_queries) {
+		int start_ID = (int)(rng() % (map_size * map_size));
+		int end_ID = (int)(rng() % (map_size * map_size));
+		if (start_ID != end_ID && grid(start_ID).get_Obstacle() == false && grid(end_ID).get_Obstacle() == false) {
+			queries.push_back(std::make_pair(start_ID, end_ID));
+		}
+	}
+
+	double base_ms = 0.0;
+	size_t base_expansions = search_queries(grid, map_size, map_size, queries, nullptr, base_ms);
+	std::cout << " " << name << " " << map_size << " x " << map_size << " | 0 | " << base_expansions << " | 1 | " << base_ms << " | - | - | -\n";
+
+	const size_t landmark_counts[] = { 1, 2, 4, 8, 16 };
+	for (size_t k = 0; k < sizeof(landmark_counts) / sizeof(landmark_counts[0]); k++) {
+
+		Landmark_heuristic landmarks;
+		landmarks.preprocess(grid, map_size, map_size, landmark_counts[k], diag_movement, adj_movement, n_threads);
+
+		double search_ms = 0.0;
+		size_t expansions = search_queries(grid, map_size, map_size, queries, &landmarks, search_ms);
+		std::cout << " " << name << " " << map_size << " x " << map_size << " | " << landmarks.get_No_of_landmarks() << " | " << expansions << " | "
+			<< (expansions > 0 ? (double)base_expansions / expansions : 0.0) << " | " << search_ms << " | " << landmarks.get_Preprocess_ms() << " | "
+			<< landmarks.get_Preprocess_ms() / landmarks.get_No_of_landmarks() << " | " << landmarks.get_Bytes_per_landmark() << "\n";
+	}
+}
+
+int main(int argc, char* argv[]) {
+
+	size_t no_of_queries = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 40;
+	size_t n_threads = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+	if (no_of_queries == 0) {
+		no_of_queries = 1;
+	}
+	if (n_threads == 0) {
+		n_threads = 1;
+	}
+
+#if GRID_LAYOUT==2
+	std::cout << "Error. The benchmark needs an in-memory grid layout (GRID_LAYOUT 0 or 1).\n";
+	exit(-1);
+#endif
+
+	std::cout << " " << no_of_queries << " queries per map, " << n_threads << " preprocessing threads\n";
+	std::cout << " map | landmarks | expansions | reduction | search ms | preprocess ms | ms per landmark | bytes per landmark\n";
+
+	run_map("rooms", false, 60, no_of_queries, n_threads);
+	run_map("rooms", false, 120, no_of_queries, n_threads);
+	run_map("maze", true, 61, no_of_queries, n_threads);
+	run_map("maze", true, 121, no_of_queries, n_threads);
+	return 0;
+}
@@ -0,0 +1,218 @@
+/* Query throughput benchmark for searches on map snapshots under a steady edit rate
+- A room map (walls every 16 cells with doors) is searched by several reader threads at once, each query with its own
+  Search_state on the shared grid and the snapshot pinned with a Read_guard. A writer thread publishes edits (8 cells each)
+  at a fixed rate while the readers run.
+- Every reader runs a fixed number of queries drawn from a pool of 16, so without edits every query after the first 16 of a
+  run can be answered by the Path_cache. Each edit rate is run without and with the cache (keyed on the snapshot version and
+  moved on by every publish, so the hit rate falls as the edit rate rises).
+- Prints queries per second, the mean query time, the cache hit rate and the number of snapshots published for every edit rate.
+
+Build from the repository root with the RMF library headers on the include path (every .cpp in the root except Source.cpp):
+	g++ -std=c++17 -O2 -pthread -I. -I<RMF include dir> $(ls *.cpp | grep -v Source.cpp) benchmarks/Map_snapshot_benchmark.cpp -o map_snapshot_benchmark
+
+Usage:
+	map_snapshot_benchmark [queries per reader] [reader threads]	(defaults 100, hardware threads - 1) */
+
+/* Include external modules */
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "A_star_functions.h"
+#include "Map_snapshot.h"
+#include "Path_cache.h"
+#include "Search_state.h"
+
+struct Run_result {
+	size_t	queries		= 0;
+	double	run_ms		= 0.0;		// Wall time until every reader finished
+	double	query_ms	= 0.0;		// Summed over all queries
+	double	hit_rate	= 0.0;		// Cache hits (whole and sub-path) per query
+	size_t	publishes	= 0;
+	size_t	unregistered	= 0;		// Reader threads which could not register (did not run)
+};
+
+/* One run: every reader thread searches queries_per_reader queries while a writer publishes edits_per_second publishes per 
+second (0 = no edits) */
+static Run_result run(Cell_grid& grid, size_t row_PT, size_t col_PT, const std::vector<std::pair<int, int>>& query_pool,
+	double edits_per_second, bool use_cache, size_t no_of_readers, size_t queries_per_reader) {
+
+	const int diag_movement = 14;
+	const int adj_movement = 10;
+
+	Map_store map_store(grid, row_PT, col_PT);
+	Path_cache path_cache(16, 1024);
+	if (use_cache == true) {
+		map_store.set_Path_cache(&path_cache);
+	}
+
+	std::atomic<bool>	stop(false);
+	std::atomic<size_t>	queries(0), publishes(0), unregistered(0);
+	std::atomic<long long>	query_us(0);
+	std::thread		writer;
+	std::vector<std::thread> readers;
+
+	// Writer, edits away from the walls so the map stays connected
+	if (edits_per_second > 0.0) {
+		writer = std::thread([&]() {
+
+			std::mt19937 rng(3);
+			std::chrono::steady_clock::duration interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / edits_per_second));
+			std::chrono::steady_clock::time_point next_publish = std::chrono::steady_clock::now();
+			std::vector<Map_edit> edits;
+
+			while (stop.load() == false) {
+
+				edits.clear();
+				while (edits.size() < 8) {
+					size_t i = rng() % row_PT;
+					size_t j = rng() % col_PT;
+					if (i % 16 != 8 && j % 16 != 8) {
+						edits.push_back(Map_edit{ i, j, (rng() % 100) < 20 });
+					}
+				}
+				map_store.publish(edits);
+				publishes += 1;
+
+				next_publish += interval;
+				std::this_thread::sleep_until(next_publish);
+			}
+		});
+	}
+
+	std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < no_of_readers; r++) {
+		readers.emplace_back([&, r]() {
+
+			int reader = map_store.register_reader();
+			if (reader == -1) {
+				unregistered += 1;
+				return;
+			}
+			std::mt19937 rng((unsigned)(11 + r));
+			std::vector<int> path_cell_IDs;
+
+			for (size_t q = 0; q < queries_per_reader; q++) {
+
+				const std::pair<int, int>& query_cells = query_pool[rng() % query_pool.size()];
+				std::chrono::steady_clock::time_point query_start = std::chrono::steady_clock::now();
+				{
+					Map_store::Read_guard map_guard(map_store, reader);
+					const Map_snapshot* map = map_guard.get();
+					Path_query query{ map->get_Version(), query_cells.first, query_cells.second, diag_movement, adj_movement };
+
+					if (use_cache == false || path_cache.lookup(query, path_cell_IDs) == false) {
+						Search_state search_state(grid, col_PT, query_cells.first, query_cells.second, map);
+						Search_outcome outcome = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, Search_limits(), nullptr, nullptr);
+						if (use_cache == true && outcome.result == Search_result::found) {
+							path_cache.insert(query, outcome.path_cell_IDs);
+						}
+					}
+				}
+				query_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - query_start).count();
+				queries += 1;
+			}
+			map_store.unregister_reader(reader);
+		});
+	}
+
+	for (size_t r = 0; r < readers.size(); r++) {
+		readers[r].join();
+	}
+	double run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - run_start).count();
+	stop.store(true);
+	if (writer.joinable() == true) {
+		writer.join();
+	}
+
+	Run_result result;
+	result.queries = queries.load();
+	result.run_ms = run_ms;
+	result.query_ms = query_us.load() / 1000.0;
+	result.hit_rate = (result.queries > 0) ? (double)(path_cache.get_Hits() + path_cache.get_Subpath_hits()) / result.queries : 0.0;
+	result.publishes = publishes.load();
+	result.unregistered = unregistered.load();
+	return result;
+}
+
+int main(int argc, char* argv[]) {
+
+	size_t queries_per_reader = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100;
+	size_t no_of_readers = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 0;
+	if (no_of_readers == 0) {
+		no_of_readers = (std::thread::hardware_concurrency() > 1) ? std::thread::hardware_concurrency() - 1 : 1;
+	}
+	if (queries_per_reader == 0) {
+		queries_per_reader = 1;
+	}
+	if (no_of_readers > Map_store::max_readers) {
+		no_of_readers = Map_store::max_readers;
+	}
+
+#if GRID_LAYOUT==2
+	std::cout << "Error. The benchmark needs an in-memory grid layout (GRID_LAYOUT 0 or 1).\n";
+	exit(-1);
+#endif
+
+	/* Room map */
+	const size_t row_PT = 256;
+	const size_t col_PT = 256;
+	Cell_grid grid(col_PT);
+	grid_generation(grid, row_PT, col_PT, 1.0f);
+	for (size_t i = 0; i < row_PT; i++) {
+		for (size_t j = 0; j < col_PT; j++) {
+			bool wall = (i % 16 == 8 || j % 16 == 8);
+			bool door = (i % 16 == 8 && j % 16 == 2) || (j % 16 == 8 && i % 16 == 2);
+			if (wall == true && door == false) {
+				grid(i, j).set_Obstacle();
+			}
+		}
+	}
+
+	/* Query pool, start and end points in rooms (never edited walls). Kept small against the queries per reader so repeated 
+	queries can hit the cache */
+	std::mt19937 rng(5);
+	std::vector<std::pair<int, int>> query_pool;
+	while (query_pool.size() < 16) {
+		int start_ID = (int)(rng() % (row_PT * col_PT));
+		int end_ID = (int)(rng() % (row_PT * col_PT));
+		if (start_ID != end_ID && grid(start_ID).get_Obstacle() == false && grid(end_ID).get_Obstacle() == false) {
+			query_pool.push_back(std::make_pair(start_ID, end_ID));
+		}
+	}
+
+	std::cout << " " << row_PT << " x " << col_PT << " room map, " << no_of_readers << " reader threads, " << queries_per_reader << " queries per reader, "
+		<< query_pool.size() << " distinct queries\n";
+	std::cout << " edits/s | cache | queries/s | mean query ms | hit rate | publishes\n";
+
+	const double edit_rates[] = { 0.0, 10.0, 100.0, 1000.0 };
+	for (size_t e = 0; e < sizeof(edit_rates) / sizeof(edit_rates[0]); e++) {
+		for (int cache = 0; cache <= 1; cache++) {
+
+			// The search logs ties of the priority list to std::cout, which is muted while the readers run
+			std::streambuf* cout_buffer = std::cout.rdbuf(nullptr);
+			Run_result result = run(grid, row_PT, col_PT, query_pool, edit_rates[e], cache == 1, no_of_readers, queries_per_reader);
+			std::cout.rdbuf(cout_buffer);
+			std::cout.clear();
+			if (result.unregistered != 0) {
+				std::cout << "Error. " << result.unregistered << " reader threads could not register and did not run.\n";
+			}
+
+			std::cout << " " << edit_rates[e] << " | " << (cache == 1 ? "on" : "off") << " | " << result.queries / (result.run_ms / 1000.0) << " | "
+				<< (result.queries > 0 ? result.query_ms / result.queries : 0.0) << " | " << result.hit_rate << " | " << result.publishes << "\n";
+		}
+	}
+	return 0;
+}
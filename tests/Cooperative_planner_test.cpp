@@ -0,0 +1,194 @@
+/* Test for Cooperative_planner: no collisions in crowded maps
+- Dense runs put 50 to 80 agents on a 12 x 12 map with a window of 3 ticks (replan interval clamped to less than the window).
+  Collisions (two agents in one cell, or two agents swapping cells) are counted here from the agent positions of every tick
+  and there must be none, get_Collisions() and get_Failed_plans() must stay 0 too.
+- A sparse run (30 x 30 map with a wall, 40 agents) must have no failed plans and no collisions, and every agent at its goal.
+- Agents with the same goal share one goal search (get_No_of_goal_searches()).
+- Prints PASS and returns 0, or prints the failures and returns 1.
+
+Build from the repository root with the RMF library headers on the include path (every .cpp in the root except Source.cpp):
+	g++ -std=c++17 -O2 -pthread -I. -I<RMF include dir> $(ls *.cpp | grep -v Source.cpp) tests/Cooperative_planner_test.cpp -o cooperative_planner_test */
+
+/* Include external modules */
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "A_star_functions.h"
+#include "Cooperative_planner.h"
+
+static size_t failures = 0;
+
+static void report_failure(const char* message, size_t value) {
+	failures += 1;
+	if (failures < 20) {
+		std::cout << "FAIL: " << message << " (" << value << ")\n";
+	}
+}
+
+/* Collisions between the positions before and after one tick */
+static size_t count_collisions(const std::vector<size_t>& before, const std::vector<size_t>& after) {
+
+	size_t count = 0;
+	std::unordered_map<size_t, size_t> cells;
+	for (size_t a = 0; a < after.size(); a++) {
+		if (cells.emplace(after[a], a).second == false) {
+			count += 1;
+		}
+	}
+	for (size_t a = 0; a < after.size(); a++) {
+		for (size_t b = a + 1; b < after.size(); b++) {
+			if (before[a] != after[a] && after[a] == before[b] && after[b] == before[a]) {
+				count += 1;
+			}
+		}
+	}
+	return count;
+}
+
+/* Distinct random passable cells */
+static std::vector<size_t> random_cells(Cell_grid& grid, size_t n_cells, size_t count, std::mt19937& rng) {
+
+	std::vector<size_t> cells;
+	for (size_t c = 0; c < n_cells; c++) {
+		if (grid(c).get_Obstacle() == false) {
+			cells.push_back(c);
+		}
+	}
+	std::shuffle(cells.begin(), cells.end(), rng);
+	cells.resize(std::min(count, cells.size()));
+	return cells;
+}
+
+/* Run a planner for a number of ticks, checking the collision count every tick. Returns the number of agents at their goal. */
+static size_t run_checked(Cooperative_planner& planner, size_t ticks) {
+
+	std::vector<size_t> before(planner.get_No_of_agents()), after(planner.get_No_of_agents());
+	for (size_t t = 0; t < ticks; t++) {
+
+		for (size_t a = 0; a < before.size(); a++) {
+			before[a] = planner.get_Agent_pos(a);
+		}
+		uint64_t failed_before = planner.get_Failed_plans();
+		uint64_t collisions_before = planner.get_Collisions();
+
+		planner.tick();
+
+		for (size_t a = 0; a < after.size(); a++) {
+			after[a] = planner.get_Agent_pos(a);
+		}
+		if (count_collisions(before, after) != 0) {
+			report_failure("collision at tick", (size_t)t);
+		}
+		if (planner.get_Collisions() != collisions_before || planner.get_Failed_plans() != failed_before) {
+			report_failure("collision or failed plan reported by the planner at tick", (size_t)t);
+		}
+	}
+
+	size_t at_goal = 0;
+	for (size_t a = 0; a < planner.get_No_of_agents(); a++) {
+		at_goal += (planner.get_Agent_at_goal(a) == true) ? 1 : 0;
+	}
+	return at_goal;
+}
+
+int main() {
+
+	const int	diag_movement = 14;
+	const int	adj_movement = 10;
+
+#if GRID_LAYOUT==2
+	std::cout << "Error. The test needs an in-memory grid layout (GRID_LAYOUT 0 or 1).\n";
+	exit(-1);
+#endif
+
+	/* ------------------------------- Dense runs ------------------------------------------- */
+	{
+		const size_t row_PT = 12;
+		const size_t col_PT = 12;
+		Cell_grid grid(col_PT);
+		grid_generation(grid, row_PT, col_PT, 1.0f);
+		for (size_t i = 3; i < 9; i++) {
+			grid(i, 6).set_Obstacle();
+		}
+
+		for (size_t no_of_agents = 50; no_of_agents <= 80; no_of_agents += 10) {
+
+			std::mt19937 rng((unsigned)no_of_agents);
+			std::vector<size_t> starts = random_cells(grid, row_PT * col_PT, no_of_agents, rng);
+			std::vector<size_t> goals = random_cells(grid, row_PT * col_PT, no_of_agents, rng);
+
+			Cooperative_planner planner(grid, row_PT, col_PT, diag_movement, adj_movement, 3, 3);
+			for (size_t a = 0; a < starts.size(); a++) {
+				planner.add_agent(starts[a], goals[a]);
+			}
+			size_t at_goal = run_checked(planner, 200);
+
+			std::cout << " " << no_of_agents << " agents: " << at_goal << " at goal, " << planner.get_Failed_plans() << " failed plans, "
+				<< planner.get_Collisions() << " collisions\n";
+		}
+	}
+
+	/* ------------------------------- Sparse run ------------------------------------------- */
+	{
+		const size_t row_PT = 30;
+		const size_t col_PT = 30;
+		Cell_grid grid(col_PT);
+		grid_generation(grid, row_PT, col_PT, 1.0f);
+		for (size_t i = 0; i < 24; i++) {
+			grid(i, 15).set_Obstacle();
+		}
+
+		std::mt19937 rng(3);
+		std::vector<size_t> starts = random_cells(grid, row_PT * col_PT, 40, rng);
+		std::vector<size_t> goals = random_cells(grid, row_PT * col_PT, 40, rng);
+
+		Cooperative_planner planner(grid, row_PT, col_PT, diag_movement, adj_movement, 8, 4);
+		for (size_t a = 0; a < starts.size(); a++) {
+			planner.add_agent(starts[a], goals[a]);
+		}
+		size_t at_goal = run_checked(planner, 300);
+		std::cout << " Sparse: " << at_goal << " of " << starts.size() << " at goal, " << planner.get_Failed_plans() << " failed plans, "
+			<< planner.get_Collisions() << " collisions\n";
+
+		if (planner.get_Failed_plans() != 0 || planner.get_Collisions() != 0) {
+			report_failure("failed plans or collisions in the sparse run", (size_t)(planner.get_Failed_plans() + planner.get_Collisions()));
+		}
+		if (at_goal != starts.size()) {
+			report_failure("agents not at their goal in the sparse run", starts.size() - at_goal);
+		}
+	}
+
+	/* ------------------------------- Shared goal searches ------------------------------------------- */
+	{
+		const size_t row_PT = 10;
+		const size_t col_PT = 10;
+		Cell_grid grid(col_PT);
+		grid_generation(grid, row_PT, col_PT, 1.0f);
+
+		Cooperative_planner planner(grid, row_PT, col_PT, diag_movement, adj_movement, 4, 2);
+		for (size_t a = 0; a < 6; a++) {
+			planner.add_agent(90 + a, (a < 3) ? 5 : 7);
+		}
+		if (planner.get_No_of_goal_searches() != 2) {
+			report_failure("goal searches not shared, searches", planner.get_No_of_goal_searches());
+		}
+		run_checked(planner, 40);
+	}
+
+	if (failures != 0) {
+		std::cout << " FAILED (" << failures << " failures)\n";
+		return 1;
+	}
+	std::cout << " PASS\n";
+	return 0;
+}
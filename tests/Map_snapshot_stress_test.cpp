@@ -0,0 +1,341 @@
+/* Stress test for Map_store: concurrent writers publishing edits while readers pin snapshots and search them
+- Writers publish random obstacle edits, and every publish also rewrites a marker row (row 0, spread over several snapshot tiles)
+  to one value. A reader which sees a marker row that is not all the same value has seen a torn snapshot.
+- Readers check that snapshot versions never go backwards, that a pinned snapshot does not change while pinned (marker row read
+  again after the search), and run a search on the pinned snapshot (each with its own Search_state on the shared grid) whose path
+  must be free of obstacles in that snapshot and made of neighbouring cells.
+- Reader slots: register_reader() must return -1 once all slots are taken, and every reader thread checks its slot.
+- Component labels and landmark tables built from an older map version must not be used on a newer snapshot (a wall gap
+  opened by a publish must not be rejected as unreachable).
+- Grid toggles through the labels must not make them reject queries on snapshots without the toggle, published edits reach
+  the labels with apply_edits, a cache set on the store keeps the snapshot versions, and out of range edits are rejected.
+- After the readers stop, one more publish must leave no retired snapshots behind.
+- Prints PASS and returns 0, or prints the failures and returns 1. Run it under -fsanitize=thread and -fsanitize=address too.
+
+Build from the repository root with the RMF library headers on the include path (every .cpp in the root except Source.cpp):
+	g++ -std=c++17 -O2 -pthread -I. -I<RMF include dir> $(ls *.cpp | grep -v Source.cpp) tests/Map_snapshot_stress_test.cpp -o map_snapshot_stress_test
+
+Usage:
+	map_snapshot_stress_test [seconds] [writers] [readers]		(defaults 5 2 6) */
+
+/* Include external modules */
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+/* Include library API */
+#include "SL_Comptime_Interface.h"
+#include "SL_Runtime_Interface.h"
+
+/* Include any internal APIs*/
+#include "Cell_ds.h"
+#include "Cell_grid.h"
+#include "A_star_functions.h"
+#include "Component_labels.h"
+#include "Landmark_heuristic.h"
+#include "Map_snapshot.h"
+#include "Search_state.h"
+
+static std::atomic<size_t>	failures(0);
+
+static void report_failure(const char* message) {
+	if (failures.fetch_add(1) < 20) {
+		std::cout << "FAIL: " << message << "\n";
+	}
+}
+
+/* Marker row (row 0) has one value across all of its tiles */
+static bool marker_row_uniform(const Map_snapshot& map, size_t col_PT) {
+	bool first = map.get_Obstacle(0, 0);
+	for (size_t j = 1; j < col_PT; j++) {
+		if (map.get_Obstacle(0, j) != first) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+
+	double	seconds		= (argc > 1) ? std::atof(argv[1]) : 5.0;
+	size_t	no_of_writers	= (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2;
+	size_t	no_of_readers	= (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 6;
+
+	const size_t	row_PT = 96;
+	const size_t	col_PT = 160;		// Marker row spans 5 snapshot tiles
+	const int	diag_movement = 14;
+	const int	adj_movement = 10;
+
+	if (no_of_readers + 1 > Map_store::max_readers) {
+		std::cout << "Error. At most " << Map_store::max_readers - 1 << " reader threads.\n";
+		exit(-1);
+	}
+
+#if GRID_LAYOUT==2
+	std::cout << "Error. The stress test needs an in-memory grid layout (GRID_LAYOUT 0 or 1).\n";
+	exit(-1);
+#endif
+	Cell_grid grid(col_PT);
+	grid_generation(grid, row_PT, col_PT, 1.0f);
+	Map_store map_store(grid, row_PT, col_PT);
+
+	/* ------------------------------- Reader slot exhaustion ------------------------------------------- */
+	{
+		std::vector<int> slots;
+		for (size_t r = 0; r < Map_store::max_readers; r++) {
+			int slot = map_store.register_reader();
+			if (slot == -1) {
+				report_failure("register_reader() returned -1 before all slots were taken");
+			}
+			slots.push_back(slot);
+		}
+		if (map_store.register_reader() != -1) {
+			report_failure("register_reader() did not return -1 with every slot taken");
+		}
+		for (size_t r = 0; r < slots.size(); r++) {
+			map_store.unregister_reader(slots[r]);
+		}
+		map_store.unregister_reader(-1);		// Must be ignored
+	}
+
+	/* ------------------------------- Tables built from an older map version ------------------------------------------- */
+	// Wall across the map, labels and landmarks built from the grid (version 0), then a gap is opened in the wall by a publish. 
+	// The search on the new snapshot must not use the stale labels (which say unreachable) or landmarks (no longer admissible)
+	{
+		Cell_grid wall_grid(col_PT);
+		grid_generation(wall_grid, row_PT, col_PT, 1.0f);
+		size_t wall_col = col_PT / 2;
+		for (size_t i = 0; i < row_PT; i++) {
+			wall_grid(i, wall_col).set_Obstacle();
+		}
+		Component_labels components;
+		components.label_components(wall_grid, row_PT, col_PT, 2);
+		Landmark_heuristic landmarks;
+		landmarks.preprocess(wall_grid, row_PT, col_PT, 4, diag_movement, adj_movement, 2);
+
+		Map_store wall_store(wall_grid, row_PT, col_PT);
+		int reader = wall_store.register_reader();
+		if (reader == -1) {
+			report_failure("could not register a reader for the wall map");
+		}
+		else {
+			int start_ID = (int)((row_PT / 2) * col_PT);
+			int end_ID = (int)(((row_PT / 2) * col_PT) + col_PT - 1);
+
+			Search_outcome before;
+			{
+				Map_store::Read_guard map_guard(wall_store, reader);
+				Search_state search_state(wall_grid, col_PT, start_ID, end_ID, map_guard.get());
+				before = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, Search_limits(), &components, &landmarks);
+			}
+			if (before.result != Search_result::unreachable || before.expansions != 0) {
+				report_failure("walled off end point not rejected by the labels of the same version");
+			}
+
+			wall_store.publish(std::vector<Map_edit>{ Map_edit{ 0, wall_col, false } });
+			{
+				Map_store::Read_guard map_guard(wall_store, reader);
+				Search_state search_state(wall_grid, col_PT, start_ID, end_ID, map_guard.get());
+				Search_outcome after = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, Search_limits(), &components, &landmarks);
+				if (after.result != Search_result::found) {
+					report_failure("stale labels rejected a query after a gap was opened");
+				}
+
+				// Labels built from the new snapshot are used again
+				Component_labels new_components;
+				new_components.label_components(*map_guard.get(), 2);
+				if (new_components.get_Map_version() != map_guard.get()->get_Version() || new_components.same_component(start_ID, end_ID) == false) {
+					report_failure("labels from the new snapshot do not join the two sides");
+				}
+			}
+			wall_store.unregister_reader(reader);
+		}
+	}
+
+	/* ------------------------------- Obstacle edits and one version source ------------------------------------------- */
+	// A grid toggle through the labels must not make them reject queries on a snapshot which does not have the toggle,
+	// published edits reach the labels with apply_edits, the cache keeps the snapshot versions and bad edits are rejected
+	{
+		Cell_grid wall_grid(col_PT);
+		grid_generation(wall_grid, row_PT, col_PT, 1.0f);
+		Map_store wall_store(wall_grid, row_PT, col_PT);		// Snapshot version 0 without the wall
+		Path_cache path_cache(4, 64);
+		wall_store.set_Path_cache(&path_cache);
+
+		Component_labels components;
+		components.label_components(wall_grid, row_PT, col_PT, 2);
+		components.set_Path_cache(&path_cache);
+		size_t wall_col = col_PT / 2;
+		for (size_t i = 0; i < row_PT; i++) {
+			components.set_Obstacle_cell(wall_grid, i, wall_col);
+		}
+		if (path_cache.get_Map_version() != 0) {
+			report_failure("grid toggles moved the version of a cache versioned by the map store");
+		}
+
+		int reader = wall_store.register_reader();
+		int start_ID = (int)((row_PT / 2) * col_PT);
+		int end_ID = (int)(((row_PT / 2) * col_PT) + col_PT - 1);
+		{
+			Map_store::Read_guard map_guard(wall_store, reader);
+			Search_state search_state(wall_grid, col_PT, start_ID, end_ID, map_guard.get());
+			Search_outcome outcome = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, Search_limits(), &components, nullptr);
+			if (outcome.result != Search_result::found) {
+				report_failure("labels of a toggled grid rejected a query on a snapshot without the toggle");
+			}
+
+			Path_query query{ map_guard.get()->get_Version(), start_ID, end_ID, diag_movement, adj_movement };
+			std::vector<int> cached_path;
+			path_cache.insert(query, outcome.path_cell_IDs);
+			if (path_cache.lookup(query, cached_path) == false) {
+				report_failure("path keyed on the snapshot version not cached after grid toggles");
+			}
+		}
+
+		// Wall published through the store, labels built from the snapshot follow the edits
+		Component_labels snapshot_components;
+		{
+			Map_store::Read_guard map_guard(wall_store, reader);
+			snapshot_components.label_components(*map_guard.get(), 2);
+		}
+		std::vector<Map_edit> wall_edits;
+		for (size_t i = 0; i < row_PT; i++) {
+			wall_edits.push_back(Map_edit{ i, wall_col, true });
+		}
+		uint64_t wall_version = wall_store.publish(wall_edits);
+		snapshot_components.apply_edits(wall_edits, wall_version);
+		{
+			Map_store::Read_guard map_guard(wall_store, reader);
+			Search_state search_state(wall_grid, col_PT, start_ID, end_ID, map_guard.get());
+			Search_outcome outcome = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, Search_limits(), &snapshot_components, nullptr);
+			if (outcome.result != Search_result::unreachable || outcome.expansions != 0) {
+				report_failure("labels updated with the published wall did not reject the query");
+			}
+		}
+
+		// Out of range edits are rejected as a whole
+		uint64_t rejected_version = wall_store.publish(std::vector<Map_edit>{ Map_edit{ 0, 0, true }, Map_edit{ row_PT, 0, true } });
+		if (rejected_version != wall_version || path_cache.get_Map_version() != wall_version) {
+			report_failure("publish with an edit outside of the map was not rejected");
+		}
+		wall_store.unregister_reader(reader);
+	}
+
+	/* ------------------------------- Writers and readers ------------------------------------------- */
+	std::atomic<bool>	stop(false);
+	std::atomic<size_t>	publishes(0), searches(0), paths_found(0);
+	std::vector<std::thread> threads;
+
+	for (size_t w = 0; w < no_of_writers; w++) {
+		threads.emplace_back([&, w]() {
+
+			std::mt19937 rng((unsigned)(101 + w));
+			std::vector<Map_edit> edits;
+			while (stop.load() == false) {
+
+				edits.clear();
+				bool marker = (rng() % 2) == 0;
+				for (size_t j = 0; j < col_PT; j++) {
+					edits.push_back(Map_edit{ 0, j, marker });
+				}
+				for (int e = 0; e < 16; e++) {
+					size_t i = 2 + (rng() % (row_PT - 2));
+					size_t j = rng() % col_PT;
+					edits.push_back(Map_edit{ i, j, (rng() % 100) < 30 });
+				}
+				map_store.publish(edits);
+				publishes += 1;
+			}
+		});
+	}
+
+	for (size_t r = 0; r < no_of_readers; r++) {
+		threads.emplace_back([&, r]() {
+
+			int reader = map_store.register_reader();
+			if (reader == -1) {
+				report_failure("reader thread could not register");
+				return;
+			}
+
+			std::mt19937 rng((unsigned)(7 + r));
+			uint64_t last_version = 0;
+			while (stop.load() == false) {
+
+				Map_store::Read_guard map_guard(map_store, reader);
+				const Map_snapshot* map = map_guard.get();
+
+				if (map->get_Version() < last_version) {
+					report_failure("snapshot version went backwards");
+				}
+				last_version = map->get_Version();
+				if (marker_row_uniform(*map, col_PT) == false) {
+					report_failure("torn snapshot (marker row not uniform)");
+				}
+				bool marker_before = map->get_Obstacle(0, 0);
+
+				// Search the pinned snapshot (start and end below the marker row)
+				int start_ID = (int)(((2 + (rng() % (row_PT - 2))) * col_PT) + (rng() % col_PT));
+				int end_ID = (int)(((2 + (rng() % (row_PT - 2))) * col_PT) + (rng() % col_PT));
+				if (start_ID == end_ID || map->get_Obstacle(start_ID / col_PT, start_ID % col_PT) == true || map->get_Obstacle(end_ID / col_PT, end_ID % col_PT) == true) {
+					continue;
+				}
+				Search_state search_state(grid, col_PT, start_ID, end_ID, map);
+				Search_limits limits;
+				Search_outcome outcome = A_star_search(search_state, row_PT, col_PT, diag_movement, adj_movement, limits, nullptr, nullptr);
+				searches += 1;
+
+				if (outcome.result == Search_result::found) {
+					paths_found += 1;
+					if (outcome.path_cell_IDs.front() != start_ID || outcome.path_cell_IDs.back() != end_ID) {
+						report_failure("path does not run from the start to the end cell");
+					}
+					for (size_t p = 0; p < outcome.path_cell_IDs.size(); p++) {
+						size_t cell = (size_t)outcome.path_cell_IDs[p];
+						if (map->get_Obstacle(cell / col_PT, cell % col_PT) == true) {
+							report_failure("path runs through an obstacle of its snapshot");
+						}
+						if (p > 0) {
+							size_t prev = (size_t)outcome.path_cell_IDs[p - 1];
+							long d_row = (long)(cell / col_PT) - (long)(prev / col_PT);
+							long d_col = (long)(cell % col_PT) - (long)(prev % col_PT);
+							if (d_row < -1 || d_row > 1 || d_col < -1 || d_col > 1) {
+								report_failure("path cells are not neighbours");
+							}
+						}
+					}
+				}
+
+				// A pinned snapshot never changes
+				if (map->get_Obstacle(0, 0) != marker_before || marker_row_uniform(*map, col_PT) == false) {
+					report_failure("pinned snapshot changed");
+				}
+			}
+			map_store.unregister_reader(reader);
+		});
+	}
+
+	std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+	stop.store(true);
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+
+	/* ------------------------------- Reclamation ------------------------------------------- */
+	map_store.publish(std::vector<Map_edit>());
+	if (map_store.get_No_of_retired() != 0) {
+		report_failure("retired snapshots left with no readers");
+	}
+
+	std::cout << " Publishes: " << publishes.load() << ", searches: " << searches.load() << ", paths found: " << paths_found.load() << "\n";
+	if (failures.load() != 0) {
+		std::cout << " FAILED (" << failures.load() << " failures)\n";
+		return 1;
+	}
+	std::cout << " PASS\n";
+	return 0;
+}